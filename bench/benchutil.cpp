@@ -0,0 +1,52 @@
+// Copyright 2021 Alex Theimer
+
+#include "benchutil.h"
+
+#include "game/game.h"
+#include "game/move.h"
+#include "util/buffer.h"
+
+using board::Board;
+using board::PieceColor;
+using board::PieceType;
+
+using game::CompressedMove;
+
+uint64_t bench::nextRandom(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+void bench::playRandomPlies(uint64_t seed, std::size_t num_plies,
+                            Board* board, PieceColor* color) {
+    *color = game::START_COLOR;
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> capture_buffer;
+    for (std::size_t ply = 0; ply < num_plies; ++ply) {
+        std::size_t num_moves =
+                game::getAllMoves(*board, *color, move_buffer.start());
+        // moves other than king captures
+        std::size_t num_playable = 0;
+        std::size_t num_captures = 0;
+        for (std::size_t i = 0; i < num_moves; ++i) {
+            CompressedMove move = move_buffer.get(i);
+            if ((move & game::MOVE_FLAG_CAPTURE) != 0) {
+                if (board->getPieceType(game::decompressMove(move).to)
+                        == PieceType::KING) {
+                    continue;
+                }
+                capture_buffer.get(num_captures++) = move;
+            }
+            move_buffer.get(num_playable++) = move;
+        }
+        uint64_t rand = nextRandom(&seed);
+        bool play_capture = (num_captures > 0) && (rand % 3 == 0);
+        CompressedMove move = play_capture
+                ? capture_buffer.get((rand >> 2) % num_captures)
+                : move_buffer.get((rand >> 2) % num_playable);
+        game::makeMove(board, move);
+        *color = board::oppositeColor(*color);
+    }
+}
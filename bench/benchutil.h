@@ -0,0 +1,38 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef BENCHUTIL_H_
+#define BENCHUTIL_H_
+
+#include <cstdint>
+
+#include "board/board.h"
+
+/*
+Helpers shared by the benchmarks, so that every benchmark given the same
+seed works on the same data across runs.
+*/
+
+namespace bench {
+
+/*
+Advances a xorshift64 generator and returns its next value.
+@param state: must not be 0 (e.g. a seed).
+*/
+uint64_t nextRandom(uint64_t* state);
+
+/*
+Plays `num_plies` pseudo-random moves on a Board, never capturing a
+king, so the game goes on. A third of the plies capture (when they
+can), so longer games thin out the Board like a real game would.
+The same seed always gives the same Board.
+
+@param seed: must not be 0.
+@param board: must be the initial board.
+@param color: set to the color to move next.
+*/
+void playRandomPlies(uint64_t seed, std::size_t num_plies,
+                     board::Board* board, board::PieceColor* color);
+
+}  // namespace bench
+
+#endif  // BENCHUTIL_H_
@@ -0,0 +1,101 @@
+// Copyright 2021 Alex Theimer
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "util/buffer.h"
+
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+/*
+Sets, then removes, a piece on each empty Square of the initial board.
+*/
+static void BM_SetRemovePiece(benchmark::State& state) {
+    Board board(game::INIT_PIECE_MAP);
+    util::Buffer<Square, Square::NUM_SQUARES> empty_buffer;
+    std::size_t num_empty = 0;
+    for (std::size_t i = 0; i < Square::NUM_SQUARES; ++i) {
+        Square square = Square::indexToSquare(i);
+        if (!board.squareIsOccupied(square)) {
+            empty_buffer.get(num_empty++) = square;
+        }
+    }
+    Piece piece{ PieceType::KNIGHT, PieceColor::WHITE };
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < num_empty; ++i) {
+            board.setPiece(piece, empty_buffer.get(i));
+            benchmark::DoNotOptimize(board);
+            board.removePiece(empty_buffer.get(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_empty);
+}
+BENCHMARK(BM_SetRemovePiece);
+
+/*
+Moves each piece of the initial board's second row forward a Square,
+then back.
+*/
+static void BM_MovePiece(benchmark::State& state) {
+    Board board(game::INIT_PIECE_MAP);
+    constexpr std::size_t NUM_COLS = Square::MAX_DIM_VALUE;
+    for (auto _ : state) {
+        for (std::size_t col = 0; col < NUM_COLS; ++col) {
+            board.movePiece(Square(1, col), Square(2, col));
+            benchmark::DoNotOptimize(board);
+            board.movePiece(Square(2, col), Square(1, col));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_COLS);
+}
+BENCHMARK(BM_MovePiece);
+
+/*
+Gets the piece at each occupied Square of the initial board.
+*/
+static void BM_GetPiece(benchmark::State& state) {
+    Board board(game::INIT_PIECE_MAP);
+    util::Buffer<Square, Square::NUM_SQUARES> square_buffer;
+    std::size_t num_occupied = board.getOccupiedSquares(square_buffer.start());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < num_occupied; ++i) {
+            benchmark::DoNotOptimize(board.getPiece(square_buffer.get(i)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_occupied);
+}
+BENCHMARK(BM_GetPiece);
+
+/*
+Lists the initial board's occupied Squares: all of them
+(state.range(0) == 0), one color's (1), or one type's (2).
+*/
+static void BM_GetOccupiedSquares(benchmark::State& state) {
+    Board board(game::INIT_PIECE_MAP);
+    util::Buffer<Square, Square::NUM_SQUARES> square_buffer;
+    std::size_t num_squares = 0;
+    for (auto _ : state) {
+        switch (state.range(0)) {
+        case 0:
+            num_squares = board.getOccupiedSquares(square_buffer.start());
+            break;
+        case 1:
+            num_squares = board.getOccupiedSquares(PieceColor::WHITE,
+                                                   square_buffer.start());
+            break;
+        default:
+            num_squares = board.getOccupiedSquares(PieceType::PAWN,
+                                                   square_buffer.start());
+            break;
+        }
+        benchmark::DoNotOptimize(square_buffer.get(0));
+    }
+    state.SetItemsProcessed(state.iterations() * num_squares);
+}
+BENCHMARK(BM_GetOccupiedSquares)->Arg(0)->Arg(1)->Arg(2);
@@ -0,0 +1,42 @@
+// Copyright 2021 Alex Theimer
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "board/piece.h"
+#include "board/square.h"
+#include "board/zobhash.h"
+
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+using board::SquareIndex;
+
+/*
+Toggles each Piece at each Square into a hash value.
+*/
+static void BM_ToggleZobPiece(benchmark::State& state) {
+    constexpr std::size_t NUM_TYPES =
+            static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES);
+    constexpr std::size_t NUM_COLORS =
+            static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS);
+    std::size_t hash = board::ZOB_INIT;
+    for (auto _ : state) {
+        for (std::size_t type = 0; type < NUM_TYPES; ++type) {
+            for (std::size_t color = 0; color < NUM_COLORS; ++color) {
+                Piece piece{ static_cast<PieceType>(type),
+                             static_cast<PieceColor>(color) };
+                for (std::size_t index = 0; index < Square::NUM_SQUARES;
+                        ++index) {
+                    hash = board::toggleZobPiece(
+                            hash, piece, static_cast<SquareIndex>(index));
+                }
+            }
+        }
+        benchmark::DoNotOptimize(hash);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_TYPES * NUM_COLORS
+                            * Square::NUM_SQUARES);
+}
+BENCHMARK(BM_ToggleZobPiece);
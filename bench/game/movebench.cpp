@@ -0,0 +1,74 @@
+// Copyright 2021 Alex Theimer
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "benchutil.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "game/move.h"
+#include "util/buffer.h"
+
+using board::Board;
+using board::PieceColor;
+
+using game::CompressedMove;
+
+/*
+Makes/unmakes every move available on a Board after state.range(0)
+random plies (0: the initial board; 24: a midgame; 64: an endgame).
+*/
+static void BM_MakeUnmakeMove(benchmark::State& state) {
+    Board board(game::INIT_PIECE_MAP);
+    PieceColor color;
+    bench::playRandomPlies(1, state.range(0), &board, &color);
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves =
+            game::getAllMoves(board, color, move_buffer.start());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < num_moves; ++i) {
+            CompressedMove move = move_buffer.get(i);
+            game::UndoInfo undo_info = game::makeMove(&board, move);
+            benchmark::DoNotOptimize(board);
+            game::unmakeMove(&board, move, undo_info);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_moves);
+}
+BENCHMARK(BM_MakeUnmakeMove)->Arg(0)->Arg(24)->Arg(64);
+
+/*
+Generates every move available on a Board after state.range(0) random
+plies (see BM_MakeUnmakeMove).
+*/
+static void BM_GetAllMoves(benchmark::State& state) {
+    Board board(game::INIT_PIECE_MAP);
+    PieceColor color;
+    bench::playRandomPlies(1, state.range(0), &board, &color);
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves = 0;
+    for (auto _ : state) {
+        num_moves = game::getAllMoves(board, color, move_buffer.start());
+        benchmark::DoNotOptimize(num_moves);
+    }
+    state.SetItemsProcessed(state.iterations() * num_moves);
+    state.counters["moves"] = num_moves;
+}
+BENCHMARK(BM_GetAllMoves)->Arg(0)->Arg(24)->Arg(64);
+
+/*
+Generates only the captures available on a Board after state.range(0)
+random plies (see BM_MakeUnmakeMove).
+*/
+static void BM_GetAllCaptures(benchmark::State& state) {
+    Board board(game::INIT_PIECE_MAP);
+    PieceColor color;
+    bench::playRandomPlies(1, state.range(0), &board, &color);
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    for (auto _ : state) {
+        std::size_t num_moves =
+                game::getAllCaptures(board, color, move_buffer.start());
+        benchmark::DoNotOptimize(num_moves);
+    }
+}
+BENCHMARK(BM_GetAllCaptures)->Arg(0)->Arg(24)->Arg(64);
@@ -0,0 +1,153 @@
+// Copyright 2021 Alex Theimer
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchutil.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "player/computer/computer.h"
+#include "player/computer/search.h"
+
+using board::Board;
+using board::PieceColor;
+
+// count of random plies played from the initial board
+static constexpr std::size_t NUM_OPENING_PLIES = 24;
+static constexpr std::size_t NUM_POSITIONS = 4;
+static constexpr std::size_t SEARCH_DEPTH = 5;
+static constexpr std::chrono::milliseconds SEARCH_TIME(200);
+
+/*
+Evaluates a few midgame Boards with basicBoardHeuristic.
+*/
+static void BM_BasicBoardHeuristic(benchmark::State& state) {
+    std::vector<Board> boards;
+    std::vector<PieceColor> colors;
+    for (uint64_t seed = 1; seed <= NUM_POSITIONS; ++seed) {
+        PieceColor color;
+        Board board(game::INIT_PIECE_MAP);
+        bench::playRandomPlies(seed, NUM_OPENING_PLIES, &board, &color);
+        boards.emplace_back(board);
+        colors.push_back(color);
+    }
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < NUM_POSITIONS; ++i) {
+            benchmark::DoNotOptimize(
+                    player::computer::basicBoardHeuristic(boards[i],
+                                                          colors[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POSITIONS);
+}
+BENCHMARK(BM_BasicBoardHeuristic);
+
+/*
+Time for a fresh Computer to search to SEARCH_DEPTH on a few midgame
+Boards, given state.range(0) threads.
+
+Reports "speedup": the 1-thread time divided by this time.
+Arguments run in increasing order, so the 1-thread time is known first.
+*/
+static void BM_TimeToDepth(benchmark::State& state) {
+    static double single_thread_seconds = 0;
+    std::size_t num_threads = state.range(0);
+    player::computer::SearchLimits limits{ SEARCH_DEPTH,
+                                           std::chrono::milliseconds::zero(),
+                                           std::chrono::milliseconds::zero(),
+                                           0 };
+
+    double total_seconds = 0;
+    for (auto _ : state) {
+        double iteration_seconds = 0;
+        for (uint64_t seed = 1; seed <= NUM_POSITIONS; ++seed) {
+            PieceColor color;
+            Board board(game::INIT_PIECE_MAP);
+            bench::playRandomPlies(seed, NUM_OPENING_PLIES, &board, &color);
+            player::Computer computer("bench", num_threads,
+                                      player::DEFAULT_HASH_SIZE_MIB, true,
+                                      limits,
+                                      player::computer::DEFAULT_PRUNING_PARAMS,
+                                      nullptr, nullptr);
+
+            auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(computer.getMove(board, color, {}));
+            std::chrono::duration<double> elapsed =
+                    std::chrono::steady_clock::now() - start;
+            iteration_seconds += elapsed.count();
+        }
+        state.SetIterationTime(iteration_seconds);
+        total_seconds += iteration_seconds;
+    }
+
+    double seconds = total_seconds / state.iterations();
+    if (num_threads == 1) {
+        single_thread_seconds = seconds;
+    }
+    if (single_thread_seconds > 0) {
+        state.counters["speedup"] = single_thread_seconds / seconds;
+    }
+}
+BENCHMARK(BM_TimeToDepth)
+    ->RangeMultiplier(2)
+    ->Range(1, 2 * std::max(1u, std::thread::hardware_concurrency()))
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+/*
+Searches a few midgame Boards for SEARCH_TIME each, without pruning
+(state.range(0) == 0) or with DEFAULT_PRUNING_PARAMS (otherwise).
+
+Reports averages over the Boards of:
+    "depth": the deepest completed iteration.
+    "ebf": the effective branching factor, i.e. nodes^(1 / depth).
+    "nps": nodes per second.
+    "hashfull": permille of the transposition table used by the search.
+*/
+static void BM_FixedTime(benchmark::State& state) {
+    const player::computer::PruningParams& pruning = (state.range(0) == 0)
+            ? player::computer::NO_PRUNING_PARAMS
+            : player::computer::DEFAULT_PRUNING_PARAMS;
+    // deepen until interrupted
+    player::computer::SearchLimits limits{
+        player::computer::MAX_SEARCH_DEPTH,
+        std::chrono::milliseconds::zero(), SEARCH_TIME, 0
+    };
+
+    double total_depth = 0;
+    double total_ebf = 0;
+    double total_nps = 0;
+    double total_hashfull = 0;
+    for (auto _ : state) {
+        for (uint64_t seed = 1; seed <= NUM_POSITIONS; ++seed) {
+            PieceColor color;
+            Board board(game::INIT_PIECE_MAP);
+            bench::playRandomPlies(seed, NUM_OPENING_PLIES, &board, &color);
+            player::Computer computer("bench", 1,
+                                      player::DEFAULT_HASH_SIZE_MIB, true,
+                                      limits, pruning, nullptr, nullptr);
+            benchmark::DoNotOptimize(computer.getMove(board, color, {}));
+
+            const player::computer::SearchStats& stats =
+                    computer.getLastSearchStats();
+            total_depth += stats.depth;
+            total_ebf += stats.getEffectiveBranchingFactor();
+            total_nps += stats.getNodesPerSecond();
+            total_hashfull += stats.hashfull;
+        }
+    }
+
+    double num_searches = state.iterations() * NUM_POSITIONS;
+    state.counters["depth"] = total_depth / num_searches;
+    state.counters["ebf"] = total_ebf / num_searches;
+    state.counters["nps"] = total_nps / num_searches;
+    state.counters["hashfull"] = total_hashfull / num_searches;
+}
+BENCHMARK(BM_FixedTime)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
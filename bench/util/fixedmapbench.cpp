@@ -0,0 +1,83 @@
+// Copyright 2021 Alex Theimer
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchutil.h"
+#include "util/fixedmap.h"
+
+using util::FixedSizeMap;
+
+// slots in each benchmarked map
+static constexpr std::size_t MAP_SIZE = 1 << 16;
+
+/*
+Returns `count` pseudo-random keys. The same seed always gives the
+same keys.
+@param seed: must not be 0.
+*/
+static std::vector<std::size_t> getRandomKeys(uint64_t seed,
+                                              std::size_t count) {
+    std::vector<std::size_t> keys;
+    keys.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        keys.push_back(bench::nextRandom(&seed));
+    }
+    return keys;
+}
+
+/*
+Finds keys in a map of MAP_SIZE slots after setting state.range(0)
+percent as many keys as it has slots. Half the keys looked up were set
+(though some were since overwritten by a collision); the rest never
+were.
+
+Reports "hit_rate": the fraction of keys found.
+*/
+static void BM_FixedSizeMapFind(benchmark::State& state) {
+    std::size_t num_set = MAP_SIZE * state.range(0) / 100;
+    FixedSizeMap<std::size_t, std::size_t> map(MAP_SIZE);
+    std::vector<std::size_t> set_keys = getRandomKeys(1, num_set);
+    for (std::size_t key : set_keys) {
+        map.set(key, key);
+    }
+    std::vector<std::size_t> missing_keys = getRandomKeys(2, num_set);
+    std::vector<std::size_t> keys;
+    for (std::size_t i = 0; i < num_set; ++i) {
+        keys.push_back(set_keys[i]);
+        keys.push_back(missing_keys[i]);
+    }
+
+    std::size_t num_hits = 0;
+    for (auto _ : state) {
+        num_hits = 0;
+        for (std::size_t key : keys) {
+            num_hits += map.find(key) != map.end();
+        }
+        benchmark::DoNotOptimize(num_hits);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    state.counters["hit_rate"] = static_cast<double>(num_hits) / keys.size();
+}
+BENCHMARK(BM_FixedSizeMapFind)->Arg(25)->Arg(50)->Arg(100)->Arg(200);
+
+/*
+Sets state.range(0) percent as many keys as a map of MAP_SIZE slots
+has, starting with an empty map each iteration.
+*/
+static void BM_FixedSizeMapSet(benchmark::State& state) {
+    std::size_t num_set = MAP_SIZE * state.range(0) / 100;
+    std::vector<std::size_t> keys = getRandomKeys(1, num_set);
+    for (auto _ : state) {
+        state.PauseTiming();
+        FixedSizeMap<std::size_t, std::size_t> map(MAP_SIZE);
+        state.ResumeTiming();
+        for (std::size_t key : keys) {
+            map.set(key, key);
+        }
+        benchmark::DoNotOptimize(map.find(keys.front()));
+    }
+    state.SetItemsProcessed(state.iterations() * num_set);
+}
+BENCHMARK(BM_FixedSizeMapSet)->Arg(25)->Arg(50)->Arg(100)->Arg(200);
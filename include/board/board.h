@@ -104,6 +104,28 @@ class Board {
     */
     void movePieceOverwrite(Square from, Square to);
 
+    /*
+    Moves a piece from one square to another, capturing any piece at `to`.
+    Only the Bitboard bits at `from` and `to` are touched, and the hash
+    is updated incrementally.
+    @param from_index: must be occupied
+    @param to_index: must not be occupied by a piece of the same color
+                     as the piece at `from_index`.
+    @return: the CompressedPiece previously at `to_index`
+             (EMPTY_COMPRESSED_PIECE if it was unoccupied).
+    */
+    CompressedPiece movePieceCapture(SquareIndex from_index,
+                                     SquareIndex to_index);
+
+    /*
+    Reverses Board::movePieceCapture.
+    @param from_index: must be unoccupied
+    @param to_index: must be occupied
+    @param captured: the result of the reversed movePieceCapture call.
+    */
+    void unmovePieceCapture(SquareIndex from_index, SquareIndex to_index,
+                            CompressedPiece captured);
+
     /*
     @note: might allow the implementation to return a result faster than Board::getPiece.
     @param square: must be occupied
@@ -128,6 +150,21 @@ class Board {
     */
     void removePiece(Square square);
 
+    /*
+    Returns a Bitboard of all Squares occupied by a piece of `color`.
+    */
+    Bitboard getColorBitboard(PieceColor color) const;
+
+    /*
+    Returns a Bitboard of all Squares occupied by a piece of `type`.
+    */
+    Bitboard getPieceTypeBitboard(PieceType type) const;
+
+    /*
+    Returns a Bitboard of all occupied Squares.
+    */
+    Bitboard getOccupancyBitboard() const;
+
     /*
     Fills a buffer with all Squares that contain a piece with the specified PieceColor.
     @param buffer: a random-access iterator at the beginning of the buffer.
@@ -169,6 +206,13 @@ class Board {
                  static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS)
              ] = { 0 };
 
+    /*
+    "Mailbox" that mirrors the Bitboards: stores the CompressedPiece at each
+    of the 64 spaces (or EMPTY_COMPRESSED_PIECE), so Piece lookups don't need
+    to step thru every Bitboard.
+    */
+    CompressedPiece mailbox_[Square::NUM_SQUARES];
+
     // Zobrist Hash value.
     std::size_t hash_;
 
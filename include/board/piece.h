@@ -16,6 +16,9 @@ enum class PieceColor { BLACK, WHITE, NUM_PIECE_COLORS };
 // TODO(theimer): move all piece compression stuff to a different namespace?
 typedef uint8_t CompressedPiece;
 
+// CompressedPiece value that describes the absence of any Piece.
+constexpr CompressedPiece EMPTY_COMPRESSED_PIECE = 0xFF;
+
 struct Piece {
     PieceType type;
     PieceColor color;
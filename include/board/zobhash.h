@@ -14,6 +14,9 @@
     Piece/Square pairs are either "included" in or "excluded" from the
     hash value.
 
+    All values are fixed at compile-time, so a hash value is identical
+    across runs.
+
 ################################################################################
 */
 
@@ -27,7 +30,6 @@ Includes/Excludes a Piece/Square pair from a hash value.
 */
 std::size_t toggleZobPiece(std::size_t hash, Piece piece, SquareIndex square_index);
 
-// TODO(theimer): use this!
 /*
 Excludes a Piece/Square pair from a hash value, and includes
 a Piece/Square pair where the second Square is identical to the first.
@@ -35,6 +37,18 @@ a Piece/Square pair where the second Square is identical to the first.
 std::size_t replaceZobPiece(std::size_t hash, Piece old_piece,
                         Piece new_piece, SquareIndex square_index);
 
+/*
+Includes/Excludes the side-to-move key from a hash value.
+*/
+std::size_t toggleZobSideToMove(std::size_t hash);
+
+/*
+Returns the hash value of a position with `color` to move, given the
+hash value of its Board.
+(i.e. the side-to-move key is included iff WHITE is to move.)
+*/
+std::size_t applyZobSideToMove(std::size_t hash, PieceColor color);
+
 }  // namespace board
 
 #endif  // BOARD_ZOBHASH_H_
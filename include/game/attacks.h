@@ -0,0 +1,59 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef GAME_ATTACKS_H_
+#define GAME_ATTACKS_H_
+
+#include "board/board.h"
+
+/*
+################################################################################
+                          ~~~ Attack Tables ~~~
+
+    Precomputed lookups of the squares each piece type attacks from a given
+    square. Every result includes squares occupied by either color, so
+    callers should mask out friendly pieces.
+
+################################################################################
+*/
+
+namespace game {
+
+/*
+Returns all squares a king at `square_index` attacks.
+Note: pawns move exactly like kings in this game, so this also
+      gives a pawn's attacks.
+*/
+board::Bitboard getKingAttacks(board::SquareIndex square_index);
+
+/*
+Returns all squares a knight at `square_index` attacks.
+*/
+board::Bitboard getKnightAttacks(board::SquareIndex square_index);
+
+/*
+Returns all squares a rook at `square_index` attacks.
+Each ray stops at (and includes) the first occupied square.
+@param occupancy: all occupied squares on the Board.
+*/
+board::Bitboard getRookAttacks(board::SquareIndex square_index,
+                               board::Bitboard occupancy);
+
+/*
+Returns all squares a bishop at `square_index` attacks.
+Each ray stops at (and includes) the first occupied square.
+@param occupancy: all occupied squares on the Board.
+*/
+board::Bitboard getBishopAttacks(board::SquareIndex square_index,
+                                 board::Bitboard occupancy);
+
+/*
+Returns all squares a queen at `square_index` attacks.
+Each ray stops at (and includes) the first occupied square.
+@param occupancy: all occupied squares on the Board.
+*/
+board::Bitboard getQueenAttacks(board::SquareIndex square_index,
+                                board::Bitboard occupancy);
+
+}  // namespace game
+
+#endif  // GAME_ATTACKS_H_
@@ -6,6 +6,7 @@
 #include <string>
 #include <ostream>
 #include <unordered_map>
+#include <vector>
 
 #include "board/board.h"
 #include "game/move.h"
@@ -22,16 +23,38 @@ class InvalidMoveEx : public std::exception {
     Move getMove() const;
  private:
     Move move_;
+    // what() must outlive the call
+    std::string message_;
 };
 
 // Square->Piece map for initialization of a standard game of chess.
 extern const std::unordered_map<board::Square, board::Piece> INIT_PIECE_MAP;
 
+// the PieceColor that makes the first move of a game
+constexpr board::PieceColor START_COLOR = board::PieceColor::BLACK;
+
+// a game is drawn once a position occurs this many times
+constexpr std::size_t NUM_REPETITIONS_DRAW = 3;
+
+/*
+Returns the key of a position: the Zobrist hash of its Board, with the
+player to move applied. Equal positions have equal keys.
+*/
+std::size_t getPositionKey(const board::Board& board,
+                           board::PieceColor color);
+
 class Player {
  public:
     explicit Player(std::string name);
     std::string getName();
-    virtual Move getMove(const board::Board& board, board::PieceColor) = 0;
+
+    /*
+    @param history: the keys (see getPositionKey) of the positions of the
+                    game before `board`, oldest first, back to the last
+                    capture (i.e. every position that could repeat).
+    */
+    virtual Move getMove(const board::Board& board, board::PieceColor,
+                         const std::vector<std::size_t>& history) = 0;
  private:
     std::string name_;
 };
@@ -47,6 +70,13 @@ class Game {
     */
     Game(board::Board* board, Player* white_player, Player* black_player);
 
+    /*
+    Instantiates a game that continues from `board` (e.g. after an
+    opening), with `next_color` to move.
+    */
+    Game(board::Board* board, Player* white_player, Player* black_player,
+         board::PieceColor next_color);
+
     void renderBoard(std::ostream& ostream) const;
 
     // TODO(theimer): C++ way to denote throws InvalidMoveEx?
@@ -56,13 +86,20 @@ class Game {
     void runPly();
 
     /*
-    Returns true iff the game is over.
+    Returns true iff the game is over: a king was captured, or the game
+    is drawn.
     */
     bool isEnded() const;
 
+    /*
+    Returns true iff the game is drawn (i.e. a position occurred
+    NUM_REPETITIONS_DRAW times).
+    */
+    bool isDrawn() const;
+
     /*
     Returns the winning Player instance.
-    The game must be ended before this member is called.
+    The game must be ended, and not drawn, before this member is called.
     */
     Player& getWinner() const;
 
@@ -71,6 +108,10 @@ class Game {
     Player* white_player_;
     Player* black_player_;
     board::PieceColor next_player_color_;
+    // the keys of the positions before the current one, back to the
+    //     last capture (see Player::getMove)
+    std::vector<std::size_t> history_;
+    bool is_drawn_;
 };
 
 }  // namespace game
@@ -3,7 +3,7 @@
 #ifndef GAME_MOVE_H_
 #define GAME_MOVE_H_
 
-#include <optional>
+#include <cstdint>
 #include <string>
 
 #include "board/board.h"
@@ -20,13 +20,66 @@ struct Move {
     board::Square to;
 };
 
+/*
+A Move packed into 16 bits (see compressMove for details).
+*/
+typedef uint16_t CompressedMove;
+
+// CompressedMove value that describes the absence of any Move.
+// (No valid Move has identical from/to Squares.)
+constexpr CompressedMove EMPTY_COMPRESSED_MOVE = 0;
+
+// Set on CompressedMoves generated by getAllMoves/getPieceMoves iff
+//     the Move captures a piece.
+constexpr CompressedMove MOVE_FLAG_CAPTURE = 0x1000;
+
+/*
+Everything needed to reverse a Move applied by makeMove.
+*/
+struct UndoInfo {
+    // piece removed from move.to (EMPTY_COMPRESSED_PIECE if none)
+    board::CompressedPiece captured;
+};
+
 bool operator==(Move lhs, Move rhs);
 std::ostream& operator<<(std::ostream& out, Move move);
 
+/*
+Packs a Move into 16 bits. No flags are set on the result.
+*/
+CompressedMove compressMove(Move move);
+
+/*
+Unpacks a CompressedMove; any flags are discarded.
+*/
+Move decompressMove(CompressedMove compressed_move);
+
+/*
+Returns the index of a CompressedMove's `from` Square.
+*/
+board::SquareIndex getMoveFromIndex(CompressedMove compressed_move);
+
+/*
+Returns the index of a CompressedMove's `to` Square.
+*/
+board::SquareIndex getMoveToIndex(CompressedMove compressed_move);
+
+/*
+Returns true iff the CompressedMove is flagged as a capture.
+*/
+bool isCaptureMove(CompressedMove compressed_move);
+
+/*
+Returns true iff the two CompressedMoves have identical from/to Squares
+(i.e. flags are ignored).
+*/
+bool isSameMove(CompressedMove lhs, CompressedMove rhs);
+
 /*
 Fills a buffer with all possible moves for the Piece at the specified Square.
 @param square: must be occupied by a Piece of PieceColor `color`
-@param buffer: a random-access iterator at the start of the buffer.
+@param buffer: a random-access iterator over CompressedMoves
+               at the start of the buffer.
 @return: the number of Moves added to the buffer.
 */
 template<typename RandomAccessIter>
@@ -35,32 +88,53 @@ std::size_t getPieceMoves(const board::Board& board, board::PieceColor color,
 
 /*
 Fills a buffer with all possible moves for Pieces of the specified color.
-@param buffer: a random-access iterator at the start of the buffer.
+@param buffer: a random-access iterator over CompressedMoves
+               at the start of the buffer.
 @return: the number of Moves added to the buffer.
 */
 template<typename RandomAccessIter>
 std::size_t getAllMoves(const board::Board& board,
                         board::PieceColor color, RandomAccessIter buffer);
 
+/*
+Fills a buffer with all possible captures for Pieces of the specified color.
+(i.e. the subset of getAllMoves that lands on an opposite-colored Piece.)
+@param buffer: a random-access iterator over CompressedMoves
+               at the start of the buffer.
+@return: the number of Moves added to the buffer.
+*/
+template<typename RandomAccessIter>
+std::size_t getAllCaptures(const board::Board& board,
+                           board::PieceColor color, RandomAccessIter buffer);
+
+/*
+Fills a buffer with all possible non-captures for Pieces of the
+specified color.
+(i.e. the subset of getAllMoves that lands on an empty Square.)
+@param buffer: a random-access iterator over CompressedMoves
+               at the start of the buffer.
+@return: the number of Moves added to the buffer.
+*/
+template<typename RandomAccessIter>
+std::size_t getAllQuiets(const board::Board& board,
+                         board::PieceColor color, RandomAccessIter buffer);
+
 /*
 Applies the specified move to the board.
 @param move: move.from must be occupied;
              move.to must be unoccupied or occupied by a piece with a
                  different color than the piece at move.from.
-@return: optional with overwritten piece (if applicable);
-         empty optional otherwise
+@return: the information needed to reverse the move via unmakeMove.
 */
-std::optional<board::Piece> makeMove(board::Board* board, Move move);
+UndoInfo makeMove(board::Board* board, CompressedMove move);
 
 /*
-Reverses a move, then sets a replacement Piece at the move's `to` Square.
+Reverses a move applied by makeMove.
 @param move: move.from must be unoccupied;
              move.to must be occupied.
-@param replacement: if non-empty, must have color different
-                    from Piece at move.to
+@param undo_info: the result of the reversed makeMove call.
 */
-void unmakeMove(board::Board* board, Move move,
-                std::optional<board::Piece> replacement);
+void unmakeMove(board::Board* board, CompressedMove move, UndoInfo undo_info);
 
 /*
 Returns true iff `move` is valid.
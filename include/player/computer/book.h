@@ -0,0 +1,131 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef PLAYER_COMPUTER_BOOK_H_
+#define PLAYER_COMPUTER_BOOK_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "board/board.h"
+#include "game/move.h"
+#include "util/mappedfile.h"
+
+namespace player {
+namespace computer {
+
+/*
+One recorded move of an opening book.
+
+A book file is a BookHeader followed by BookEntries sorted by (key, move).
+Values are stored in the byte order of the machine that wrote the file.
+*/
+struct BookEntry {
+    // the position's getBookKey
+    uint64_t key;
+    game::CompressedMove move;
+    // how often `move` was played, relative to the position's other entries
+    uint16_t weight;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(BookEntry) == 16, "BookEntry must be packed");
+
+struct BookHeader {
+    char magic[8];
+    uint64_t num_entries;
+};
+
+/*
+Returns the key a position's entries are stored under.
+(i.e. its Zobrist hash with the player to move applied.)
+*/
+uint64_t getBookKey(const board::Board& board, board::PieceColor color);
+
+/*
+Parses a game record: whitespace-separated "row_from col_from row_to col_to"
+quadruples (the same form a Human enters), one per move.
+@throws std::invalid_argument if the record is malformed.
+*/
+std::vector<game::Move> parseGameRecord(const std::string& record);
+
+/*
+A read-only opening book, mapped into memory from a file written by
+OpeningBookBuilder. Probes binary-search the mapped entries, so they cost
+a few cache misses rather than a search.
+*/
+class OpeningBook {
+ public:
+    /*
+    @throws std::runtime_error if the file cannot be mapped
+            or is not a book.
+    */
+    explicit OpeningBook(const std::string& path);
+
+    /*
+    Returns the total number of entries in the book.
+    */
+    std::size_t size() const;
+
+    /*
+    Finds the entries recorded for a position.
+    @param entries: set to the first entry iff any exist; the rest follow
+                    contiguously, sorted by move.
+    @return: the number of entries (0 if the position is out of book).
+    */
+    std::size_t getEntries(const board::Board& board, board::PieceColor color,
+                           const BookEntry** entries) const;
+
+    /*
+    Chooses one of a position's recorded moves at random, in proportion
+    to their weights. Moves that are invalid on `board` (i.e. key
+    collisions) are never chosen.
+    @return: the chosen move, or EMPTY_COMPRESSED_MOVE if none exist.
+    */
+    game::CompressedMove pickMove(const board::Board& board,
+                                  board::PieceColor color) const;
+
+ private:
+    util::MappedFile file_;
+    const BookEntry* entries_;
+    std::size_t num_entries_;
+};
+
+/*
+Accumulates the openings of recorded games into a book file.
+*/
+class OpeningBookBuilder {
+ public:
+    OpeningBookBuilder();
+
+    /*
+    Records the first moves of a game played from game::INIT_PIECE_MAP,
+    game::START_COLOR moving first.
+    @param max_plies: the number of moves to record; later ones are ignored.
+    @throws game::InvalidMoveEx if one of the recorded moves is invalid
+            (nothing is recorded in that case).
+    */
+    void addGame(const std::vector<game::Move>& moves, std::size_t max_plies);
+
+    /*
+    Returns the number of distinct (position, move) pairs recorded.
+    */
+    std::size_t size() const;
+
+    /*
+    Writes every recorded (position, move) pair, weighted by the number of
+    games it was played in.
+    @throws std::runtime_error if the file cannot be written.
+    */
+    void write(const std::string& path) const;
+
+ private:
+    std::map<std::pair<uint64_t, game::CompressedMove>, std::size_t> counts_;
+};
+
+}  // namespace computer
+}  // namespace player
+
+#endif  // PLAYER_COMPUTER_BOOK_H_
@@ -4,34 +4,113 @@
 #define PLAYER_COMPUTER_H_
 
 #include <string>
+#include <vector>
 
 #include "game/game.h"
-#include "util/fixedmap.h"
-#include "player/computer/scorecache.h"
+#include "util/bucketmap.h"
+#include "player/computer/book.h"
+#include "player/computer/tablebase.h"
+#include "player/computer/transposition.h"
 #include "player/computer/search.h"
 
 namespace player {
 
+// the transposition table size of a Computer, unless configured otherwise
+constexpr std::size_t DEFAULT_HASH_SIZE_MIB = 4;
 
 class Computer : public game::Player {
  public:
-    explicit Computer(std::string name);
-    game::Move getMove(const board::Board& board, board::PieceColor) override;
+    /*
+    @param num_threads: count of threads to search with; must be >= 1.
+    @param hash_size_mib: the most memory, in MiB, for the transposition
+                          table, which is kept between getMove calls for
+                          the same color (its scores are stored from the
+                          searching color's perspective). It
+                          holds a power of two of buckets, so the table
+                          takes the largest such size that fits;
+                          must be >= 1.
+    @param randomize_ties: whether to choose randomly between equally good
+                           moves (see negamaxSearch).
+    @param limits: the budget of each move's search.
+    @param pruning: the selective pruning of each move's search.
+    @param book: consulted before each search; a position in the book is
+                 played without searching. nullptr searches every move.
+    @param tablebases: score the endgames they hold exactly during each
+                       search; may be nullptr.
+    */
+    Computer(std::string name, std::size_t num_threads,
+             std::size_t hash_size_mib, bool randomize_ties,
+             const player::computer::SearchLimits& limits,
+             const player::computer::PruningParams& pruning,
+             const player::computer::OpeningBook* book,
+             const player::computer::Tablebases* tablebases);
+    game::Move getMove(const board::Board& board, board::PieceColor color,
+                       const std::vector<std::size_t>& history) override;
+
+    /*
+    Stops a getMove search (e.g. from another thread); getMove then
+    returns the best move it has found so far. A stop requested before
+    the search starts (e.g. right after getMove is called) stops it as
+    soon as its first iteration completes. Once getMove returns, the
+    stop is cleared, so it has no effect on later getMove calls.
+    */
+    void stop();
+
+    /*
+    Returns the measurements of the latest getMove search
+    (all zero if the move came from the book).
+    */
+    const player::computer::SearchStats& getLastSearchStats() const;
+
+    /*
+    Returns the line of play expected by the latest getMove search,
+    starting with the returned move.
+    */
+    const std::vector<game::CompressedMove>& getLastPrincipalVariation() const;
 
  private:
-    class ScoreCacheImpl : public util::FixedSizeMap<std::size_t,
-                                                  player::computer::BoardScore>,
-                           public player::computer::IScoreCache {
+    /*
+    A player::computer::TTEntry, packed into 8 bytes.
+    */
+    struct PackedTTEntry {
+        int32_t score;
+        game::CompressedMove best_move;
+        uint8_t draft;
+        // ScoreBound in the low bits; generation in the rest.
+        uint8_t bound_generation;
+    };
+
+    class TranspositionTableImpl :
+            public util::BucketedMap<PackedTTEntry>,
+            public player::computer::ITranspositionTable {
      public:
-        explicit ScoreCacheImpl(std::size_t size);
-        player::computer::BoardScore* end() const override;
-        player::computer::BoardScore* find(const board::Board& board,
-                                           std::size_t depth) const override;
-        void set(const board::Board& board, std::size_t depth,
-                 player::computer::BoardScore value) override;
+        explicit TranspositionTableImpl(std::size_t num_buckets);
+        bool probe(const board::Board& board, board::PieceColor color,
+                   player::computer::TTEntry* entry) const override;
+        bool store(const board::Board& board, board::PieceColor color,
+                   player::computer::BoardScore score,
+                   game::CompressedMove best_move, std::size_t draft,
+                   player::computer::ScoreBound bound) override;
+        void newSearch() override;
+        std::size_t getHashfull() const override;
+
+     private:
+        uint8_t generation_;
     };
 
-    ScoreCacheImpl score_cache_;
+    TranspositionTableImpl transposition_table_;
+    // the color transposition_table_'s entries were searched for
+    //     (NUM_PIECE_COLORS while it's empty)
+    board::PieceColor table_color_;
+    const std::size_t num_threads_;
+    const bool randomize_ties_;
+    const player::computer::SearchLimits limits_;
+    const player::computer::PruningParams pruning_;
+    const player::computer::OpeningBook* book_;
+    const player::computer::Tablebases* tablebases_;
+    player::computer::StopToken stop_token_;
+    player::computer::SearchStats last_search_stats_;
+    std::vector<game::CompressedMove> last_principal_variation_;
 };
 
 }  // namespace player
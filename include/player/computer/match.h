@@ -0,0 +1,167 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef PLAYER_COMPUTER_MATCH_H_
+#define PLAYER_COMPUTER_MATCH_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "board/board.h"
+#include "game/move.h"
+#include "player/computer/pruning.h"
+#include "player/computer/search.h"
+
+namespace player {
+namespace computer {
+
+/*
+One of the two Computers of a match.
+*/
+struct EngineConfig {
+    std::string name;
+    // the transposition table size, in MiB (see player::Computer)
+    std::size_t hash_size_mib;
+    SearchLimits limits;
+    PruningParams pruning;
+};
+
+enum class GameOutcome {
+    WIN,
+    DRAW,
+    LOSS,
+};
+
+/*
+The result of one game of a match, from the first engine's perspective.
+*/
+struct MatchGameResult {
+    // games are numbered from 0, in the order they were started
+    std::size_t game_index;
+    // the index of the opening the game was played from
+    std::size_t opening_index;
+    // the first engine's color
+    board::PieceColor first_color;
+    GameOutcome outcome;
+    // the plies played by the engines (i.e. not counting the opening)
+    std::size_t num_plies;
+};
+
+/*
+The first engine's results over the games of a match.
+*/
+struct MatchResults {
+    std::size_t num_wins;
+    std::size_t num_draws;
+    std::size_t num_losses;
+
+    std::size_t getNumGames() const;
+
+    /*
+    Returns the fraction of points scored (a draw being half a point).
+    Returns 0.5 if no game was played.
+    */
+    double getScore() const;
+
+    /*
+    Returns the Elo difference implied by the score; +/- infinity if
+    every game was won/lost.
+    */
+    double getEloDifference() const;
+};
+
+enum class SprtDecision {
+    // the results can't yet tell the hypotheses apart
+    CONTINUE,
+    // the first engine is at most elo0 stronger
+    ACCEPT_H0,
+    // the first engine is at least elo1 stronger
+    ACCEPT_H1,
+};
+
+/*
+A sequential probability ratio test of two hypotheses about the first
+engine's strength: H0 "it's elo0 stronger" against H1 "it's elo1
+stronger". The log-likelihood ratio of the results is updated after
+every game, and the test stops once it leaves (lower, upper) bounds set
+by the error rates, so a match lasts only as long as it takes to decide.
+
+The ratio is the usual normal approximation of the trinomial (i.e. win,
+draw, loss) likelihoods, with logistic Elo. Each outcome is counted as
+if half a game more of it had been played, so that a few games of a
+single outcome (i.e. no variance) aren't decisive on their own.
+*/
+class Sprt {
+ public:
+    /*
+    @param elo0: must be < elo1.
+    @param alpha: the rate of accepting H1 when H0 holds; in (0, 0.5).
+    @param beta: the rate of accepting H0 when H1 holds; in (0, 0.5).
+    @throws std::invalid_argument if a parameter is out of range.
+    */
+    Sprt(double elo0, double elo1, double alpha, double beta);
+
+    double getLowerBound() const;
+    double getUpperBound() const;
+
+    double getLogLikelihoodRatio(const MatchResults& results) const;
+
+    SprtDecision getDecision(const MatchResults& results) const;
+
+ private:
+    // the expected scores under H0 and H1
+    double score0_;
+    double score1_;
+    double lower_bound_;
+    double upper_bound_;
+};
+
+/*
+How a match is played.
+*/
+struct MatchOptions {
+    // the most games to play; each opening is played twice in a row,
+    //     the engines swapping colors
+    std::size_t num_games;
+    // games played at the same time (each engine searches with 1 thread,
+    //     and each game holds both engines' transposition tables)
+    std::size_t num_threads;
+    // a game still going after this many plies (not counting the
+    //     opening) is a draw, as is a game drawn by repetition
+    std::size_t max_plies;
+    // stops the match once decided; may be nullptr.
+    const Sprt* sprt;
+};
+
+/*
+Called with each game's result and the match's results so far. Calls are
+serialized (i.e. never concurrent), and made in the order games end.
+*/
+typedef std::function<void(const MatchGameResult& game,
+                           const MatchResults& results)> MatchCallback;
+
+/*
+Plays a match of `first` against `second`, on a pool of worker threads.
+
+Games start from the positions after each opening, in turn, from
+game::INIT_PIECE_MAP. If an SPRT decides the match, no new game is
+started, and the games in progress are abandoned (i.e. not counted).
+
+@param openings: each a sequence of moves from the initial position,
+                 game::START_COLOR moving first; empty plays every game
+                 from the initial position.
+@param callback: may be nullptr.
+@return: the results of every completed game.
+@throws game::InvalidMoveEx if an opening contains an invalid move.
+@throws std::invalid_argument if an opening ends the game, or if
+        options.num_threads is 0.
+*/
+MatchResults runMatch(const EngineConfig& first, const EngineConfig& second,
+                      const std::vector<std::vector<game::Move>>& openings,
+                      const MatchOptions& options,
+                      const MatchCallback& callback);
+
+}  // namespace computer
+}  // namespace player
+
+#endif  // PLAYER_COMPUTER_MATCH_H_
@@ -0,0 +1,75 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef PLAYER_COMPUTER_MOVEORDER_H_
+#define PLAYER_COMPUTER_MOVEORDER_H_
+
+#include <cstdint>
+
+#include "board/board.h"
+#include "game/move.h"
+
+namespace player {
+namespace computer {
+
+/*
+Move-ordering state learned during a single search:
+    - "killer" moves: quiet moves that caused a cutoff at some ply.
+      A sibling node (i.e. same ply) will often be cut off by the
+      same move.
+    - a "butterfly" history table: how often (weighted by depth) each
+      quiet from-to pair has caused a cutoff, for each color.
+
+Captures are ordered statically by getCaptureScore (MVV-LVA).
+*/
+class MoveOrdering {
+ public:
+    // plies [0, MAX_PLY) have killer slots
+    static constexpr std::size_t MAX_PLY = 128;
+    static constexpr std::size_t NUM_KILLERS = 2;
+
+    MoveOrdering();
+
+    /*
+    Returns the ordering score of a capture: "Most Valuable Victim,
+    Least Valuable Attacker". Higher scores should be searched first.
+
+    @param move: must be a capture on `board`.
+    */
+    static int32_t getCaptureScore(const board::Board& board,
+                                   game::CompressedMove move);
+
+    /*
+    Returns the killer in `slot` at `ply`, or game::EMPTY_COMPRESSED_MOVE.
+    Killers are only known to be valid at the node that stored them.
+
+    @param slot: must be < NUM_KILLERS; lower slots are more recent.
+    */
+    game::CompressedMove getKiller(std::size_t ply, std::size_t slot) const;
+
+    /*
+    Returns the history score of a quiet move for `color`.
+    */
+    int32_t getHistoryScore(board::PieceColor color,
+                            game::CompressedMove move) const;
+
+    /*
+    Records that a quiet move caused a cutoff.
+    Captures are ignored; they're already ordered first.
+
+    @param depth_remaining: of the node that was cut off.
+    */
+    void updateCutoff(board::PieceColor color, game::CompressedMove move,
+                      std::size_t ply, std::size_t depth_remaining);
+
+ private:
+    game::CompressedMove killers_[MAX_PLY][NUM_KILLERS];
+    int32_t history_[static_cast<std::size_t>(
+                        board::PieceColor::NUM_PIECE_COLORS)]
+                    [board::Square::NUM_SQUARES]
+                    [board::Square::NUM_SQUARES];
+};
+
+}  // namespace computer
+}  // namespace player
+
+#endif  // PLAYER_COMPUTER_MOVEORDER_H_
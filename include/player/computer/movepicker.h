@@ -0,0 +1,95 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef PLAYER_COMPUTER_MOVEPICKER_H_
+#define PLAYER_COMPUTER_MOVEPICKER_H_
+
+#include <cstdint>
+
+#include "board/board.h"
+#include "game/move.h"
+#include "player/computer/moveorder.h"
+#include "util/buffer.h"
+
+namespace player {
+namespace computer {
+
+/*
+Incrementally supplies the moves of a single search node in stages:
+    (1) the best known move (if any),
+    (2) captures, by descending MVV-LVA score,
+    (3) quiet moves: killer moves of the node's ply first, then the
+        rest by descending history score.
+
+A stage's moves are only generated once every move of the previous stage
+has been returned (i.e. at the next call to next()), so a cutoff during
+an early stage skips the rest of the generation work.
+
+Note: the Board must be in the same state at every call to next()
+      (i.e. any moves made by the caller must be unmade).
+*/
+class MovePicker {
+ public:
+    /*
+    @param best_move: searched first if it's a valid move for `color`.
+                      May be game::EMPTY_COMPRESSED_MOVE.
+    @param ordering: supplies killers and history scores; must outlive
+                     the MovePicker.
+    @param ply: distance of the node from the root.
+    */
+    MovePicker(const board::Board& board, board::PieceColor color,
+               game::CompressedMove best_move,
+               const MoveOrdering& ordering, std::size_t ply);
+
+    /*
+    Supplies only the captures stage (i.e. for a quiescence search).
+    */
+    MovePicker(const board::Board& board, board::PieceColor color);
+
+    /*
+    Returns the next move to search, or game::EMPTY_COMPRESSED_MOVE
+    once every move has been returned.
+    */
+    game::CompressedMove next();
+
+ private:
+    // (GENERATE_CAPTURES follows the best move, so its captures are only
+    //     generated once the best move fails to cause a cutoff)
+    enum class Stage { BEST_MOVE, GENERATE_CAPTURES, CAPTURES, QUIETS, DONE };
+
+    const board::Board& board_;
+    board::PieceColor color_;
+    game::CompressedMove best_move_;
+    // nullptr if only captures are supplied
+    const MoveOrdering* ordering_;
+    std::size_t ply_;
+    Stage stage_;
+
+    // moves of the current stage, with their scores;
+    //     [next_index_, num_moves_) remain.
+    util::Buffer<game::CompressedMove, game::MAX_NUM_MOVES_PLY> moves_;
+    util::Buffer<int32_t, game::MAX_NUM_MOVES_PLY> scores_;
+    std::size_t num_moves_;
+    std::size_t next_index_;
+
+    /*
+    Sets scores_ for the quiet moves in moves_.
+    */
+    void scoreQuiets();
+
+    /*
+    Sorts moves_ (and scores_) by descending score; ties keep their
+    generation order.
+    */
+    void sortStage();
+
+    /*
+    Fills moves_ with the moves of the stage that follows stage_,
+    then advances stage_.
+    */
+    void generateNextStage();
+};
+
+}  // namespace computer
+}  // namespace player
+
+#endif  // PLAYER_COMPUTER_MOVEPICKER_H_
@@ -0,0 +1,78 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef PLAYER_COMPUTER_PRUNING_H_
+#define PLAYER_COMPUTER_PRUNING_H_
+
+#include <cstdint>
+
+#include "game/move.h"
+
+namespace player {
+namespace computer {
+
+/*
+Configuration of the search's selective pruning:
+    - null-move pruning: the player to move "passes", and the opponent
+      searches to a reduced depth. If the player's score is still at
+      least beta, a real move would (almost always) be too, so the node
+      is cut off without searching any move.
+    - late move reductions (LMR): quiet moves searched late at a node
+      are unlikely to be best (i.e. move ordering put them there), so
+      they're searched to a reduced depth. A reduced move that beats
+      alpha is searched again to the full depth.
+*/
+struct PruningParams {
+    // null moves are tried at nodes with at least this much depth
+    //     remaining; 0 disables null-move pruning.
+    std::size_t null_move_min_depth;
+    // the depth by which a null move's search is reduced (beyond the
+    //     one ply of the null move itself)
+    std::size_t null_move_reduction;
+    // quiet moves are reduced at nodes with at least this much depth
+    //     remaining; 0 disables late move reductions.
+    std::size_t lmr_min_depth;
+    // ... but only from this move index (0 being the first move searched)
+    std::size_t lmr_min_move_index;
+    // a reduction is floor(lmr_base + ln(depth) * ln(index) / lmr_divisor)
+    double lmr_base;
+    double lmr_divisor;
+};
+
+constexpr PruningParams DEFAULT_PRUNING_PARAMS = { 3, 2, 3, 3, 0.75, 2.25 };
+// every move is searched to full depth
+constexpr PruningParams NO_PRUNING_PARAMS = { 0, 0, 0, 0, 0, 1 };
+
+/*
+Late move reductions, tabulated by depth remaining and move index.
+*/
+class ReductionTable {
+ public:
+    // depths [0, MAX_DEPTH] have entries
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    /*
+    @param params: lmr_divisor must be > 0.
+    */
+    explicit ReductionTable(const PruningParams& params);
+
+    /*
+    Returns the reduction of a quiet move at `move_index`, at a node
+    with `depth_remaining`. Always leaves at least one ply to search
+    (i.e. the result is < depth_remaining, or 0).
+
+    @param depth_remaining: must be <= MAX_DEPTH.
+    @param move_index: must be < game::MAX_NUM_MOVES_PLY.
+    */
+    std::size_t get(std::size_t depth_remaining,
+                    std::size_t move_index) const {
+        return reductions_[depth_remaining][move_index];
+    }
+
+ private:
+    uint8_t reductions_[MAX_DEPTH + 1][game::MAX_NUM_MOVES_PLY];
+};
+
+}  // namespace computer
+}  // namespace player
+
+#endif  // PLAYER_COMPUTER_PRUNING_H_
@@ -3,10 +3,15 @@
 #ifndef PLAYER_COMPUTER_SEARCH_H_
 #define PLAYER_COMPUTER_SEARCH_H_
 
+#include <atomic>
+#include <chrono>
 #include <unordered_map>
+#include <vector>
 
 #include "game/game.h"
-#include "player/computer/scorecache.h"
+#include "player/computer/pruning.h"
+#include "player/computer/tablebase.h"
+#include "player/computer/transposition.h"
 
 namespace player {
 namespace computer {
@@ -14,25 +19,66 @@ namespace computer {
 typedef BoardScore (*BoardHeuristicFunc)(const board::Board&,
                                          board::PieceColor color);
 
+// the deepest a search may go (i.e. drafts must fit in a TTEntry)
+constexpr std::size_t MAX_SEARCH_DEPTH = 64;
+
 /*
-Searches the tree of possible Boards to a certain depth, and returns
-the best-possible Move that an opponent might allow.
+The budget of a single search.
 
-Note that there might be multiple "best-possible" Moves. When this
-happens, one of the "best-possible" Moves is ***RANDOMLY*** returned.
+The search deepens one ply at a time until one of the limits is hit,
+then returns the best move of the deepest completed iteration. The
+first iteration always completes, so a move is always returned.
 
-@param color: color of the player to plan the move
-@param depth: must be >= 1
-@param board_heuristic: accepts a Board and color, and returns a
-    heuristic value of the Board from the "color" player's perspective
-@param score_cache: Can contain existing pairs.
-                    Will be updated with additional scores.
+Zero-valued time and node limits are unlimited.
 */
-game::Move alphaBetaSearch(
-        const board::Board& board, board::PieceColor color,
-        std::size_t depth,
-        BoardHeuristicFunc board_heuristic,
-        player::computer::IScoreCache* score_cache);
+struct SearchLimits {
+    // deepest iteration to run; must be in [1, MAX_SEARCH_DEPTH]
+    std::size_t max_depth;
+    // no new iteration starts after this much time has passed
+    std::chrono::milliseconds soft_time;
+    // the search is interrupted once this much time has passed
+    std::chrono::milliseconds hard_time;
+    // the search is interrupted once every thread together has searched
+    //     (about) this many nodes; threads report their counts in batches.
+    std::size_t max_nodes;
+};
+
+/*
+Lets another thread stop a running search (e.g. to serve a user who
+stopped waiting). The search notices within a bounded delay (i.e. a
+single node of the calling thread), then returns the best move of its
+deepest completed iteration.
+
+Like the other limits, a stop only takes effect once the first
+iteration completes, so a move is always returned.
+*/
+class StopToken {
+ public:
+    StopToken() : stopped_(false) {
+        // intentionally blank
+    }
+
+    /*
+    Stops any search using this token. Safe to call from any thread.
+    */
+    void requestStop() {
+        stopped_.store(true, std::memory_order_relaxed);
+    }
+
+    /*
+    Allows searches using this token to run again.
+    */
+    void reset() {
+        stopped_.store(false, std::memory_order_relaxed);
+    }
+
+    bool isStopRequested() const {
+        return stopped_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    std::atomic<bool> stopped_;
+};
 
 /*
 Returns the negative of the count of oppositely-colored pieces.
@@ -45,6 +91,215 @@ i.e. "More enemies = worse."
 BoardScore basicBoardHeuristic(const board::Board& board,
                                board::PieceColor color);
 
+// cutoffs are counted by move index up to this many indices;
+//     the last one counts every later index too
+constexpr std::size_t NUM_CUTOFF_MOVE_INDICES = 8;
+
+/*
+Counts of the work done by one thread of a search.
+
+Every thread counts into its own SearchCounters (i.e. no cache lines
+are shared), which are only added together once the search ends.
+*/
+struct SearchCounters {
+    // nodes searched, including quiescence nodes
+    std::size_t num_nodes;
+    // of those, nodes of the quiescence search
+    std::size_t num_quiescence_nodes;
+    // calls to the evaluator
+    std::size_t num_evaluations;
+    // transposition table probes, and those that found an entry
+    std::size_t num_tt_probes;
+    std::size_t num_tt_hits;
+    // transposition table stores, and those that evicted another
+    //     position's entry
+    std::size_t num_tt_stores;
+    std::size_t num_tt_overwrites;
+    // nodes where a move caused a beta cutoff, by the index of that
+    //     move (0 being the first move searched)
+    std::size_t num_cutoffs;
+    std::size_t num_cutoffs_by_move_index[NUM_CUTOFF_MOVE_INDICES];
+    // nodes scored by a tablebase probe (i.e. without a search)
+    std::size_t num_tablebase_hits;
+
+    /*
+    Adds every count of `other` to this.
+    */
+    void add(const SearchCounters& other);
+};
+
+/*
+Measurements taken when an iteration (of iterative deepening) completes.
+*/
+struct IterationStats {
+    std::size_t depth;
+    // nodes searched by the calling thread, since the search started
+    std::size_t num_nodes;
+    // time since the search started
+    std::chrono::microseconds elapsed;
+};
+
+/*
+Measurements of a single search.
+*/
+struct SearchStats {
+    // the deepest completed iteration
+    std::size_t depth;
+    // duration of the whole search
+    std::chrono::microseconds elapsed;
+    // the counts of every thread, added together
+    SearchCounters total;
+    // the counts of each thread; the calling thread's are first
+    std::vector<SearchCounters> threads;
+    // every completed iteration of the calling thread, in order
+    std::vector<IterationStats> iterations;
+    // the transposition table's permille of entries from this search
+    std::size_t hashfull;
+
+    /*
+    Returns the fraction of cutoffs caused by the first move searched;
+    a measure of move ordering quality. Returns 0 if there were no cutoffs.
+    */
+    double getFirstMoveCutoffRate() const;
+
+    /*
+    Returns the effective branching factor: the branching factor of a
+    uniform tree as deep as the deepest completed iteration, with as many
+    nodes as were searched (by every thread). Returns 0 if no iteration
+    completed.
+    */
+    double getEffectiveBranchingFactor() const;
+
+    /*
+    Returns the nodes searched (by every thread) per second.
+    Returns 0 if no time was measured.
+    */
+    double getNodesPerSecond() const;
+};
+
+/*
+An "evaluator" is any type with the method:
+
+    BoardScore operator()(const board::Board& board,
+                          board::PieceColor color) const;
+
+that returns a heuristic value of the Board from the "color" player's
+perspective, within (-MIN_WIN_SCORE, MIN_WIN_SCORE). The search is compiled
+separately for each evaluator type, so calls to it can be inlined.
+*/
+
+/*
+Evaluates Boards with basicBoardHeuristic.
+*/
+class BasicBoardEvaluator {
+ public:
+    BoardScore operator()(const board::Board& board,
+                          board::PieceColor color) const {
+        return basicBoardHeuristic(board, color);
+    }
+};
+
+/*
+Evaluates Boards with an arbitrary BoardHeuristicFunc (i.e. one
+indirect call per evaluation).
+*/
+class HeuristicFuncEvaluator {
+ public:
+    explicit HeuristicFuncEvaluator(BoardHeuristicFunc board_heuristic) :
+            board_heuristic_(board_heuristic) {
+        // intentionally blank
+    }
+
+    BoardScore operator()(const board::Board& board,
+                          board::PieceColor color) const {
+        return board_heuristic_(board, color);
+    }
+
+ private:
+    BoardHeuristicFunc board_heuristic_;
+};
+
+/*
+Searches the tree of possible Boards with iterative deepening, and
+returns the best-possible Move that an opponent might allow.
+
+Note that there might be multiple "best-possible" Moves. When this
+happens, one of the "best-possible" Moves is ***RANDOMLY*** returned
+(unless randomize_ties is false).
+
+Each iteration searches the root moves in order of their scores from
+the previous iteration. Its leaves are extended with a search of only
+captures (i.e. a quiescence search), so they're never evaluated in the
+middle of an exchange.
+
+Instantiated for BasicBoardEvaluator and HeuristicFuncEvaluator.
+
+@param color: color of the player to plan the move; must have a move.
+@param history: if not nullptr, the keys of the positions played before
+                `board` (see game::Player::getMove). A position that
+                repeats one of them, or one earlier in its line of the
+                search, is scored as a draw (by the evaluator) rather
+                than searched.
+@param limits: see SearchLimits.
+@param pruning: see PruningParams. Unless it's NO_PRUNING_PARAMS, moves
+                can be missed that a full-width search would find.
+@param evaluator: see the "evaluator" description above.
+@param transposition_table: Can contain existing entries.
+                    Will be updated with additional entries.
+                    Must be safe for concurrent use if num_threads > 1.
+                    Scores are stored from the perspective of `color`,
+                    so a table should only be shared between searches
+                    for the same color.
+@param tablebases: if not nullptr, a position (besides the root) that
+                    they hold is scored by its distance to a king
+                    capture (see WIN_SCORE) rather than searched; draws
+                    are scored by the evaluator.
+@param num_threads: must be >= 1. Any threads beyond the calling one
+                    are Lazy SMP helpers: they search the same Board
+                    and share results through transposition_table.
+@param randomize_ties: if false, the first of the best moves (in the
+                    order the last iteration searched them) is returned
+                    instead, so that a search with one thread, and
+                    without time limits, is fully reproducible.
+@param stop_token: if not nullptr, stops the search once a stop is
+                    requested (see StopToken).
+@param stats: if not nullptr, set to the measurements of the search.
+@param principal_variation: if not nullptr, set to the line of play the
+                    search expects: the returned move, then the best
+                    replies of each player (as deep as the deepest
+                    completed iteration, excluding captures found by
+                    the quiescence search).
+*/
+template <typename Evaluator>
+game::CompressedMove negamaxSearch(
+        const board::Board& board, board::PieceColor color,
+        const std::vector<std::size_t>* history,
+        const SearchLimits& limits,
+        const PruningParams& pruning,
+        const Evaluator& evaluator,
+        player::computer::ITranspositionTable* transposition_table,
+        const Tablebases* tablebases,
+        std::size_t num_threads,
+        bool randomize_ties,
+        const StopToken* stop_token,
+        SearchStats* stats,
+        std::vector<game::CompressedMove>* principal_variation);
+
+/*
+Equivalent to negamaxSearch with a HeuristicFuncEvaluator, limited
+only by depth, without pruning (i.e. NO_PRUNING_PARAMS).
+
+@param depth: must be in [1, MAX_SEARCH_DEPTH]
+@param board_heuristic: accepts a Board and color, and returns a
+    heuristic value of the Board from the "color" player's perspective
+*/
+game::CompressedMove alphaBetaSearch(
+        const board::Board& board, board::PieceColor color,
+        std::size_t depth,
+        BoardHeuristicFunc board_heuristic,
+        player::computer::ITranspositionTable* transposition_table,
+        std::size_t num_threads);
+
 }  // namespace computer
 }  // namespace player
 
@@ -0,0 +1,93 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef PLAYER_COMPUTER_TABLEBASE_H_
+#define PLAYER_COMPUTER_TABLEBASE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "board/board.h"
+#include "util/mappedfile.h"
+
+namespace player {
+namespace computer {
+
+// tables hold positions of at most this many pieces (kings included)
+constexpr std::size_t MAX_TABLEBASE_PIECES = 4;
+
+/*
+Endgame tablebases: the outcome of every position of a few pieces under
+perfect play, as the number of plies until a king is captured.
+
+Tables are named by their material: each side's pieces, kings first,
+e.g. "KQvK" or "KRvKN" (letters K, Q, R, B, N, P). Colors play no part
+in the rules, so "KQvK" covers the queen on either side, and "KvKQ"
+names the same table. The side with more (or, if equally many, more
+valuable) pieces is listed first.
+
+A table file is a 32-byte header, then one int8_t per position:
+    0:  a draw (i.e. neither player can force a king capture),
+    d > 0: the player to move captures the opposing king in d plies,
+    d < 0: the player to move loses their king in -d plies.
+Positions are indexed by the player to move (first side's, then the
+other's), then by the square of each piece in the order of the name.
+*/
+class Tablebases {
+ public:
+    /*
+    Maps every table (i.e. "*.tb" file) in a directory.
+    @throws std::runtime_error if a table cannot be mapped or is invalid.
+    */
+    explicit Tablebases(const std::string& directory);
+
+    /*
+    Returns the most pieces any mapped table holds (0 if there are none).
+    */
+    std::size_t getMaxPieces() const;
+
+    /*
+    Looks up a position.
+    @param color: the player to move.
+    @param value: set to the position's value (see above) iff found.
+    @return: true iff a table holds the position.
+    */
+    bool probe(const board::Board& board, board::PieceColor color,
+               int* value) const;
+
+    /*
+    Generates a table (and any missing table reached by a capture from it)
+    by retrograde analysis, writing each to `directory`.
+
+    Every position that captures a king, or captures into a smaller table
+    with a known result, is resolved first. From then on, each step takes
+    the positions resolved by the step before (i.e. at distance d - 1) and
+    unmakes each of their moves: a predecessor of a lost position is won
+    at distance d, and a predecessor whose moves all lead to won positions
+    is lost at distance d. Whatever is never resolved is a draw.
+
+    @param name: a table name, as described above.
+    @param num_threads: the positions of each step are split among this
+                        many threads; must be >= 1.
+    @throws std::invalid_argument if the name is invalid.
+    @throws std::runtime_error if a table cannot be written, or if some
+            distance is too long for the file format.
+    */
+    static void generate(const std::string& name, const std::string& directory,
+                         std::size_t num_threads);
+
+ private:
+    struct Table {
+        std::unique_ptr<util::MappedFile> file;
+        const int8_t* values;
+    };
+
+    std::unordered_map<std::string, Table> tables_;
+    std::size_t max_pieces_;
+};
+
+}  // namespace computer
+}  // namespace player
+
+#endif  // PLAYER_COMPUTER_TABLEBASE_H_
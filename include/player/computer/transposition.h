@@ -0,0 +1,100 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef PLAYER_COMPUTER_TRANSPOSITION_H_
+#define PLAYER_COMPUTER_TRANSPOSITION_H_
+
+#include <cstdint>
+
+#include "board/board.h"
+#include "game/move.h"
+
+namespace player {
+namespace computer {
+
+typedef int64_t BoardScore;
+
+// Every score lies within [-MAX_SCORE, MAX_SCORE]; the range is
+//     symmetric so that any score can be negated.
+constexpr BoardScore MAX_SCORE = INT32_MAX;
+
+// A forced king capture scores WIN_SCORE, less the number of plies (from
+//     the root of the search) until the capture; being captured scores
+//     the negation. Every other score (e.g. an evaluation) lies strictly
+//     within (-MIN_WIN_SCORE, MIN_WIN_SCORE).
+constexpr BoardScore WIN_SCORE = MAX_SCORE / 2;
+constexpr BoardScore MIN_WIN_SCORE = WIN_SCORE - 1024;
+
+/*
+Describes how a stored score relates to the true score of its node.
+*/
+enum class ScoreBound : uint8_t {
+    EXACT,  // the score is exact
+    LOWER,  // the search failed high; the true score is >= the score
+    UPPER   // the search failed low; the true score is <= the score
+};
+
+/*
+Everything the search stores about a single position.
+*/
+struct TTEntry {
+    BoardScore score;
+    // move that produced the score (EMPTY_COMPRESSED_MOVE if none)
+    game::CompressedMove best_move;
+    // depth_remaining of the search that produced the score
+    uint8_t draft;
+    ScoreBound bound;
+    // the search (see ITranspositionTable::newSearch) that stored the entry
+    uint8_t generation;
+};
+
+/*
+Interface of a "transposition table": a data structure that allows fast
+storage/retrieval of search results. Entries are keyed on Board-color
+pairs, where the color is the side to move.
+
+Implementations shared by a multi-threaded search must tolerate
+concurrent probes and stores; a probe may miss, but must never return
+a corrupt entry.
+*/
+class ITranspositionTable {
+ public:
+    /*
+    Copies the entry stored for the Board-color pair into `entry`.
+
+    @return: true iff an entry was found; `entry` is unmodified otherwise.
+    */
+    virtual bool probe(const board::Board& board, board::PieceColor color,
+                       TTEntry* entry) const = 0;
+
+    /*
+    Stores a search result for the Board-color pair.
+
+    The table may decline to overwrite an existing entry that's more
+    valuable (i.e. searched deeper during the current search).
+
+    @param best_move: may be game::EMPTY_COMPRESSED_MOVE.
+    @param draft: the depth_remaining of the node.
+    @return: true iff the entry of another Board-color pair was
+             overwritten (i.e. evicted) to make room.
+    */
+    virtual bool store(const board::Board& board, board::PieceColor color,
+                       BoardScore score, game::CompressedMove best_move,
+                       std::size_t draft, ScoreBound bound) = 0;
+
+    /*
+    Marks the start of a new search. Entries stored by earlier searches
+    are replaced before entries stored by the current search.
+    */
+    virtual void newSearch() = 0;
+
+    /*
+    Returns the permille of the table's entries that were stored during
+    the current search; may be estimated from a sample of the entries.
+    */
+    virtual std::size_t getHashfull() const = 0;
+};
+
+}  // namespace computer
+}  // namespace player
+
+#endif  // PLAYER_COMPUTER_TRANSPOSITION_H_
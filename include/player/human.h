@@ -4,6 +4,7 @@
 #define PLAYER_HUMAN_H_
 
 #include <string>
+#include <vector>
 
 #include "game/game.h"
 
@@ -12,8 +13,8 @@ namespace player {
 class Human : public game::Player {
  public:
     explicit Human(std::string name);
-    game::Move getMove(const board::Board& board,
-                       board::PieceColor color) override;
+    game::Move getMove(const board::Board& board, board::PieceColor color,
+                       const std::vector<std::size_t>& history) override;
 };
 
 }  // namespace player
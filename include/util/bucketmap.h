@@ -0,0 +1,215 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef UTIL_BUCKETMAP_H_
+#define UTIL_BUCKETMAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace util {
+
+/*
+Hash table of fixed size, laid out for cache efficiency.
+
+Entries are grouped into cache-line-sized (and -aligned) "buckets"; a key
+may be stored in any entry of the bucket its low bits select. A probe
+therefore costs one mask and (at most) one cache miss.
+
+Values must be 8-byte, trivially-copyable types (i.e. packed structs).
+Keys are 64-bit hashes; the key 0 is reserved to mark empty entries.
+
+When a bucket is full, callers choose which entry is replaced (see set()).
+
+The map is safe to share between threads without locks. Each entry
+stores (key XOR value) next to the value; a read that races a write
+sees a mismatched pair, which fails key verification and reads as a
+miss rather than as a corrupt value.
+*/
+template <typename V>
+class BucketedMap {
+ public:
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /*
+    @param num_buckets: must be a power of two.
+    */
+    explicit BucketedMap(std::size_t num_buckets) :
+            mask_(num_buckets - 1),
+            buckets_(new Bucket[num_buckets]()) {
+        ASSERT(util::isPow2(num_buckets),
+               "num_buckets must be a power of two: "
+               + std::to_string(num_buckets));
+    }
+
+    ~BucketedMap() {
+        delete[] buckets_;
+    }
+
+    BucketedMap(const BucketedMap&) = delete;
+    BucketedMap& operator=(const BucketedMap&) = delete;
+
+    /*
+    Returns the total count of entries in the map.
+    */
+    std::size_t capacity() const {
+        return (mask_ + 1) * ENTRIES_PER_BUCKET;
+    }
+
+    /*
+    Copies the value stored at `key` into `value`.
+
+    @return: true iff `key` exists in the map; `value` is unmodified otherwise.
+    */
+    bool find(std::uint64_t key, V* value) const {
+        ASSERT(key != EMPTY_KEY, "key is reserved");
+        const Bucket& bucket = buckets_[getIndex(key)];
+        for (const Entry& entry : bucket.entries) {
+            std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+            if (entry.getKey(data) == key) {
+                std::memcpy(value, &data, sizeof(V));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+    Sets the value at the key.
+
+    If `key` already exists in its bucket, that entry is overwritten.
+    Otherwise, an empty entry is used if one exists; if not, the entry
+    with the lowest `priority` is replaced.
+
+    @param priority: accepts a stored value and returns a signed integer;
+        entries with lower values are replaced first.
+    @return: true iff the value of another key was replaced.
+    */
+    template <typename PriorityFunc>
+    bool set(std::uint64_t key, const V& value, PriorityFunc priority) {
+        ASSERT(key != EMPTY_KEY, "key is reserved");
+        Bucket& bucket = buckets_[getIndex(key)];
+        std::size_t replace_index = 0;
+        int64_t replace_priority = std::numeric_limits<int64_t>::max();
+        bool evicts = true;
+        for (std::size_t i = 0; i < ENTRIES_PER_BUCKET; ++i) {
+            const Entry& entry = bucket.entries[i];
+            std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+            std::uint64_t entry_key = entry.getKey(data);
+            if (entry_key == key) {
+                replace_index = i;
+                evicts = false;
+                break;
+            }
+            if (entry_key == EMPTY_KEY) {
+                // Keep looking; the key may still exist further on.
+                replace_priority = std::numeric_limits<int64_t>::min();
+                replace_index = i;
+                evicts = false;
+                continue;
+            }
+            V entry_value;
+            std::memcpy(&entry_value, &data, sizeof(V));
+            int64_t entry_priority = priority(entry_value);
+            if (entry_priority < replace_priority) {
+                replace_priority = entry_priority;
+                replace_index = i;
+            }
+        }
+        std::uint64_t data;
+        std::memcpy(&data, &value, sizeof(V));
+        Entry& replace = bucket.entries[replace_index];
+        replace.check.store(key ^ data, std::memory_order_relaxed);
+        replace.data.store(data, std::memory_order_relaxed);
+        return evicts;
+    }
+
+    /*
+    Copies the value of an entry into `value`, regardless of its key
+    (e.g. to sample how full the map is).
+
+    @param index: must be < capacity().
+    @return: true iff the entry is occupied; `value` is unmodified otherwise.
+    */
+    bool getEntry(std::size_t index, V* value) const {
+        ASSERT(index < capacity(), "index out of range: "
+               + std::to_string(index));
+        const Entry& entry = buckets_[index / ENTRIES_PER_BUCKET]
+                             .entries[index % ENTRIES_PER_BUCKET];
+        std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        if (entry.getKey(data) == EMPTY_KEY) {
+            return false;
+        }
+        std::memcpy(value, &data, sizeof(V));
+        return true;
+    }
+
+    /*
+    Empties the map. Not safe to call concurrently with other methods.
+    */
+    void clear() {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            for (Entry& entry : buckets_[i].entries) {
+                entry.check.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+ private:
+    static_assert(sizeof(V) == sizeof(std::uint64_t),
+                  "values must be packed into 8 bytes");
+    static_assert(std::is_trivially_copyable<V>::value,
+                  "values must be trivially copyable");
+
+    static constexpr std::uint64_t EMPTY_KEY = 0;
+
+    /*
+    An all-zero Entry is empty (i.e. holds EMPTY_KEY).
+    */
+    struct Entry {
+        // key XOR data
+        std::atomic<std::uint64_t> check;
+        // the value's bytes
+        std::atomic<std::uint64_t> data;
+
+        /*
+        Returns the key the entry was stored with, given `data`
+        (i.e. an already-loaded copy of the data member).
+        */
+        std::uint64_t getKey(std::uint64_t data) const {
+            return check.load(std::memory_order_relaxed) ^ data;
+        }
+    };
+
+    static constexpr std::size_t ENTRIES_PER_BUCKET =
+            CACHE_LINE_SIZE / sizeof(Entry);
+
+    struct alignas(CACHE_LINE_SIZE) Bucket {
+        Entry entries[ENTRIES_PER_BUCKET];
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "entries must be lock-free");
+    static_assert(sizeof(Bucket) == CACHE_LINE_SIZE,
+                  "a bucket must fill exactly one cache line");
+
+    const std::size_t mask_;
+    Bucket* const buckets_;
+
+    /*
+    Given a key, returns a matching bucket index.
+    */
+    std::size_t getIndex(std::uint64_t key) const {
+        return key & mask_;
+    }
+};
+
+}  // namespace util
+
+#endif  // UTIL_BUCKETMAP_H_
@@ -0,0 +1,44 @@
+// Copyright 2021 Alex Theimer
+
+#ifndef UTIL_MAPPEDFILE_H_
+#define UTIL_MAPPEDFILE_H_
+
+#include <cstdint>
+#include <string>
+
+namespace util {
+
+/*
+A whole file, mapped read-only into memory for as long as this exists.
+Pages are read from the file (and cached by the OS) on first access, so
+files far bigger than what's actually accessed cost little.
+*/
+class MappedFile {
+ public:
+    /*
+    @throws std::runtime_error if the file cannot be opened or mapped.
+    */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /*
+    Returns the first byte of the file (nullptr if the file is empty).
+    */
+    const uint8_t* data() const;
+
+    /*
+    Returns the size of the file in bytes.
+    */
+    std::size_t size() const;
+
+ private:
+    void* mapping_;
+    std::size_t size_;
+};
+
+}  // namespace util
+
+#endif  // UTIL_MAPPEDFILE_H_
@@ -5,7 +5,7 @@
 #include <unordered_map>
 #include <algorithm>
 #include <utility>
-#include <stdexcept>
+#include <iterator>
 #include <sstream>
 #include <string>
 
@@ -20,6 +20,8 @@ using board::Bitboard;
 using board::PieceType;
 using board::PieceColor;
 using board::DimIndex;
+using board::SquareIndex;
+using board::CompressedPiece;
 
 /*
 ################################################################################
@@ -105,42 +107,23 @@ PieceColor Board::getPieceColorIndex(std::size_t index) const {
             "invalid index: " + std::to_string(index));
     ASSERT(squareIsOccupiedIndex(index),
             "unoccupied index: " + makeIndexSquareString(index));
-    // step thru all PieceColor bitboards and check for occupancy at `square`
-    for (std::size_t i = 0;
-           i < static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS);
-           ++i) {
-        Bitboard board = color_bitboards_[i];
-        if (util::getBit(board, index)) {
-            return static_cast<PieceColor>(i);
-        }
-    }
-    throw std::runtime_error("should never reach here");
+    return board::decompressPiece(mailbox_[index]).color;
 }
 
-// TODO(theimer): basically a copy-pasted of getPieceColoIndex
 PieceType Board::getPieceTypeIndex(std::size_t index) const {
     ASSERT(Square::isValidIndex(index),
             "invalid index: " + std::to_string(index));
     ASSERT(squareIsOccupiedIndex(index),
             "unoccupied index: " + makeIndexSquareString(index));
-    // step thru all PieceType bitboards and check for occupancy at the index
-    for (std::size_t i = 0;
-            i < static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES);
-            ++i) {
-        Bitboard board = piece_bitboards_[i];
-        if (util::getBit(board, index)) {
-            return static_cast<PieceType>(i);
-        }
-    }
-    throw std::runtime_error("should never reach here");
+    return board::decompressPiece(mailbox_[index]).type;
 }
 
 Piece Board::getPieceIndex(std::size_t index) const {
     ASSERT(Square::isValidIndex(index),
             "invalid index: " + std::to_string(index));
-    PieceType type = getPieceTypeIndex(index);
-    PieceColor color = getPieceColorIndex(index);
-    return Piece{ type, color };
+    ASSERT(squareIsOccupiedIndex(index),
+            "unoccupied index: " + makeIndexSquareString(index));
+    return board::decompressPiece(mailbox_[index]);
 }
 
 void Board::setPieceIndex(Piece piece, std::size_t index) {
@@ -152,8 +135,7 @@ void Board::setPieceIndex(Piece piece, std::size_t index) {
                  index, true);
     util::setBit(&this->color_bitboards_[static_cast<std::size_t>(piece.color)],
                  index, true);
-    // All Board constructors initialize hash_, so I have no idea why gcc
-    //     thinks this might be uninitialized.
+    mailbox_[index] = board::compressPiece(piece);
     hash_ = toggleZobPiece(hash_, piece, index);
     ASSERT(squareIsOccupiedIndex(index),
             "index unoccupied after set: " + makeIndexSquareString(index));
@@ -190,23 +172,19 @@ void Board::removePieceIndex(std::size_t index) {
     ASSERT(Square::isValidIndex(index),
             "invalid index: " + std::to_string(index));
 
-    // deal with the hash (TODO(theimer): something better!)
-    if (squareIsOccupiedIndex(index)) {
-        Piece piece = getPieceIndex(index);
+    // the mailbox tells us exactly which two bits need to be cleared
+    CompressedPiece compressed_piece = mailbox_[index];
+    if (compressed_piece != board::EMPTY_COMPRESSED_PIECE) {
+        Piece piece = board::decompressPiece(compressed_piece);
+        util::setBit(
+                &piece_bitboards_[static_cast<std::size_t>(piece.type)],
+                index, false);
+        util::setBit(
+                &color_bitboards_[static_cast<std::size_t>(piece.color)],
+                index, false);
+        mailbox_[index] = board::EMPTY_COMPRESSED_PIECE;
         hash_ = toggleZobPiece(hash_, piece, index);
     }
-
-    // set the color and piece bits to zero
-    for (std::size_t i = 0;
-            i < static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS);
-            ++i) {
-        util::setBit(&color_bitboards_[i], index, false);
-    }
-    for (std::size_t i = 0;
-            i < static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES);
-            ++i) {
-        util::setBit(&piece_bitboards_[i], index, false);
-    }
     ASSERT(!squareIsOccupiedIndex(index),
             "index occupied after remove: " + makeIndexSquareString(index));
 }
@@ -222,8 +200,7 @@ void Board::setPieceOverwriteIndex(Piece piece, std::size_t index) {
                  index, true);
     util::setBit(&this->color_bitboards_[static_cast<std::size_t>(piece.color)],
                  index, true);
-
-
+    mailbox_[index] = board::compressPiece(piece);
     hash_ = toggleZobPiece(hash_, piece, index);
 
     // ifdef w/ named variable prevents different
@@ -263,11 +240,86 @@ void Board::movePieceOverwriteIndex(std::size_t from_index,
     #endif  // DEBUG
 }
 
+CompressedPiece Board::movePieceCapture(SquareIndex from_index,
+                                        SquareIndex to_index) {
+    ASSERT(Square::isValidIndex(from_index),
+            "invalid 'from' index: " + std::to_string(from_index));
+    ASSERT(Square::isValidIndex(to_index),
+            "invalid 'to' index: " + std::to_string(to_index));
+    ASSERT(squareIsOccupiedIndex(from_index),
+            "from index unoccupied: " + makeIndexSquareString(from_index));
+    ASSERT(!squareIsOccupiedColorIndex(to_index,
+                                       getPieceColorIndex(from_index)),
+            "to index occupied by same color: "
+            + makeIndexSquareString(to_index));
+    CompressedPiece moved_compressed = mailbox_[from_index];
+    CompressedPiece captured_compressed = mailbox_[to_index];
+    Piece moved = board::decompressPiece(moved_compressed);
+    Bitboard to_bit = static_cast<Bitboard>(1) << to_index;
+    Bitboard from_to_bits = (static_cast<Bitboard>(1) << from_index) | to_bit;
+
+    // flip the mover's bits at both squares
+    piece_bitboards_[static_cast<std::size_t>(moved.type)] ^= from_to_bits;
+    color_bitboards_[static_cast<std::size_t>(moved.color)] ^= from_to_bits;
+    hash_ = toggleZobPiece(hash_, moved, from_index);
+
+    if (captured_compressed != board::EMPTY_COMPRESSED_PIECE) {
+        // clear the captured piece's bits.
+        // Note: if the types match, this (correctly) re-sets the bit at `to`.
+        Piece captured = board::decompressPiece(captured_compressed);
+        piece_bitboards_[static_cast<std::size_t>(captured.type)] ^= to_bit;
+        color_bitboards_[static_cast<std::size_t>(captured.color)] ^= to_bit;
+        hash_ = replaceZobPiece(hash_, captured, moved, to_index);
+    } else {
+        hash_ = toggleZobPiece(hash_, moved, to_index);
+    }
+
+    mailbox_[to_index] = moved_compressed;
+    mailbox_[from_index] = board::EMPTY_COMPRESSED_PIECE;
+    return captured_compressed;
+}
+
+void Board::unmovePieceCapture(SquareIndex from_index, SquareIndex to_index,
+                               CompressedPiece captured_compressed) {
+    ASSERT(Square::isValidIndex(from_index),
+            "invalid 'from' index: " + std::to_string(from_index));
+    ASSERT(Square::isValidIndex(to_index),
+            "invalid 'to' index: " + std::to_string(to_index));
+    ASSERT(!squareIsOccupiedIndex(from_index),
+            "from index occupied: " + makeIndexSquareString(from_index));
+    ASSERT(squareIsOccupiedIndex(to_index),
+            "to index unoccupied: " + makeIndexSquareString(to_index));
+    // exactly the reverse of movePieceCapture
+    CompressedPiece moved_compressed = mailbox_[to_index];
+    Piece moved = board::decompressPiece(moved_compressed);
+    Bitboard to_bit = static_cast<Bitboard>(1) << to_index;
+    Bitboard from_to_bits = (static_cast<Bitboard>(1) << from_index) | to_bit;
+
+    piece_bitboards_[static_cast<std::size_t>(moved.type)] ^= from_to_bits;
+    color_bitboards_[static_cast<std::size_t>(moved.color)] ^= from_to_bits;
+    hash_ = toggleZobPiece(hash_, moved, from_index);
+
+    if (captured_compressed != board::EMPTY_COMPRESSED_PIECE) {
+        Piece captured = board::decompressPiece(captured_compressed);
+        piece_bitboards_[static_cast<std::size_t>(captured.type)] ^= to_bit;
+        color_bitboards_[static_cast<std::size_t>(captured.color)] ^= to_bit;
+        hash_ = replaceZobPiece(hash_, moved, captured, to_index);
+    } else {
+        hash_ = toggleZobPiece(hash_, moved, to_index);
+    }
+
+    mailbox_[from_index] = moved_compressed;
+    mailbox_[to_index] = captured_compressed;
+}
+
 Board::Board() : hash_(board::ZOB_INIT) {
-    // intentionally blank
+    std::fill(std::begin(mailbox_), std::end(mailbox_),
+              board::EMPTY_COMPRESSED_PIECE);
 }
 
 Board::Board(const Board& other) : hash_(other.hash_) {
+    std::copy(std::begin(other.mailbox_), std::end(other.mailbox_),
+              std::begin(mailbox_));
     // TODO(theimer): C++ memmove?
     for (std::size_t i = 0;
             i < static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS);
@@ -281,10 +333,9 @@ Board::Board(const Board& other) : hash_(other.hash_) {
     }
 }
 
-Board::Board(const std::unordered_map<Square, Piece>& piece_map) {
+Board::Board(const std::unordered_map<Square, Piece>& piece_map) : Board() {
     // Just step thru map elements and set each piece at its square.
     // Note: all field array indices are already initialized to zero.
-    std::size_t hash = board::ZOB_INIT;
     for (auto iterator = piece_map.begin();
              iterator != piece_map.end();
              ++iterator)  {
@@ -294,9 +345,7 @@ Board::Board(const std::unordered_map<Square, Piece>& piece_map) {
                 "square occupied: " + std::to_string(square));
         SquareIndex square_index = Square::squareToIndex(square);
         this->setPieceIndex(piece, square_index);
-        hash = toggleZobPiece(hash, piece, square_index);
     }
-    hash_ = hash;
 }
 
 bool Board::squareIsOccupied(Square square) const {
@@ -351,6 +400,19 @@ Piece Board::getPiece(Square square) const {
     return getPieceIndex(index);
 }
 
+Bitboard Board::getColorBitboard(PieceColor color) const {
+    return color_bitboards_[static_cast<std::size_t>(color)];
+}
+
+Bitboard Board::getPieceTypeBitboard(PieceType type) const {
+    return piece_bitboards_[static_cast<std::size_t>(type)];
+}
+
+Bitboard Board::getOccupancyBitboard() const {
+    return color_bitboards_[static_cast<std::size_t>(PieceColor::WHITE)]
+         | color_bitboards_[static_cast<std::size_t>(PieceColor::BLACK)];
+}
+
 std::size_t std::hash<Board>::operator()(const board::Board& board) const {
     return board.hash_;
 }
@@ -21,17 +21,22 @@ Note: compressed pieces are built as follows:
 */
 
 // Number of bits used to represent each enum in a compressed Piece.
-// TODO(theimer): make all of these constexpr
-static const std::size_t NUM_PIECE_COLOR_BITS =
-        util::log2Ceil(static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS));
-static const std::size_t NUM_PIECE_TYPE_BITS =
-        util::log2Ceil(static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES));
+// Note: constexpr so compression stays a couple of shifts/masks; these
+//     run every time a Board reads its mailbox.
+static constexpr std::size_t NUM_PIECE_COLOR_BITS = 1;
+static constexpr std::size_t NUM_PIECE_TYPE_BITS = 3;
+static_assert((static_cast<std::size_t>(1) << NUM_PIECE_COLOR_BITS)
+                  >= static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS),
+              "too few PieceColor bits");
+static_assert((static_cast<std::size_t>(1) << NUM_PIECE_TYPE_BITS)
+                  >= static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES),
+              "too few PieceType bits");
 
 // masks used to extract Piece data from its compressed format
-static const std::size_t PIECE_COLOR_MASK =
-        ((std::size_t)1 << NUM_PIECE_COLOR_BITS) - 1;
-static const std::size_t PIECE_TYPE_MASK =
-        ((std::size_t)1 << NUM_PIECE_TYPE_BITS) - 1;
+static constexpr std::size_t PIECE_COLOR_MASK =
+        (static_cast<std::size_t>(1) << NUM_PIECE_COLOR_BITS) - 1;
+static constexpr std::size_t PIECE_TYPE_MASK =
+        (static_cast<std::size_t>(1) << NUM_PIECE_TYPE_BITS) - 1;
 
 std::string std::to_string(Piece piece) {
     std::stringstream ss;
@@ -6,15 +6,18 @@
 #include <sstream>
 
 #include "util/assert.h"
-#include "util/math.h"
 
 using board::Square;
 using board::SquareIndex;
 
-// TODO(theimer): make these constexpr
-const std::size_t NUM_DIM_BITS = util::log2Ceil(Square::MAX_DIM_VALUE);
-const std::size_t DIM_MASK =
+// Note: these must be constexpr; other translation units (i.e. attack
+//     tables) convert Squares/indices during static initialization.
+constexpr std::size_t NUM_DIM_BITS = 3;
+constexpr std::size_t DIM_MASK =
         (static_cast<std::size_t>(1) << NUM_DIM_BITS) - 1;
+static_assert((static_cast<std::size_t>(1) << NUM_DIM_BITS)
+                  == Square::MAX_DIM_VALUE,
+              "NUM_DIM_BITS must be log2(MAX_DIM_VALUE)");
 
 Square::Square(DimIndex row, DimIndex col) : row(row), col(col) {
     ASSERT(row >= 0 && row < Square::MAX_DIM_VALUE,
@@ -2,10 +2,8 @@
 
 #include "board/zobhash.h"
 
-#include <vector>
-
-#include "util/rand.h"
-#include "util/math.h"
+#include <array>
+#include <cstdint>
 
 using board::Piece;
 using board::PieceColor;
@@ -24,29 +22,50 @@ using board::Square;
     As long as these values contain sufficient entropy, the "aggregate" can
     be used as a Board's hash value.
 
-    This implementation uses 64-bit strings and std::mt19937_64 to generate
-    the Piece/Square pair values. These values are stored into a single
-    std::vector, where a specific Square/Piece index is found by
-    calling getZobIndex.
+    This implementation uses 64-bit strings generated at compile-time by
+    SplitMix64 from a fixed seed, so hash values are identical across runs
+    and processes (i.e. they're safe to write to disk). These values are
+    stored into a single std::array, where a specific Square/Piece index is
+    found by calling getZobIndex. The final element is the side-to-move key.
 
 ################################################################################
 */
 
-/*
-Fills a vector with a random 64-bit string for every valid
-Square/PieceColor/PieceType combination.
-*/
-static std::vector<std::size_t> makeZobVec();
-
 // these only de-clutter the below code
 static constexpr std::size_t NUM_TYPES =
             static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES);
 static constexpr std::size_t NUM_COLORS =
             static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS);
 
-// TODO(theimer): just hard-code this.
+// One value for every Square/PieceColor/PieceType combo, plus the
+//     side-to-move key.
+static constexpr std::size_t ZOB_ARRAY_SIZE =
+            Square::NUM_SQUARES * NUM_TYPES * NUM_COLORS + 1;
+static constexpr std::size_t ZOB_SIDE_TO_MOVE_INDEX = ZOB_ARRAY_SIZE - 1;
+
+// ***Changing this invalidates every hash value ever written to disk.***
+static constexpr std::uint64_t ZOB_SEED = 0x3243F6A8885A308DULL;
+
+/*
+Fills an array with a pseudo-random 64-bit string at every index.
+*/
+static constexpr std::array<std::size_t, ZOB_ARRAY_SIZE> makeZobArray() {
+    std::array<std::size_t, ZOB_ARRAY_SIZE> zob_array = {};
+    std::uint64_t state = ZOB_SEED;
+    for (std::size_t i = 0; i < ZOB_ARRAY_SIZE; ++i) {
+        // SplitMix64; see: https://prng.di.unimi.it/splitmix64.c
+        state += 0x9E3779B97F4A7C15ULL;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        zob_array[i] = z ^ (z >> 31);
+    }
+    return zob_array;
+}
+
 // Contains a random 64-bit value for every Square/PieceColor/PieceType combo.
-static const std::vector<std::size_t> ZOB_ARRAY = makeZobVec();
+static constexpr std::array<std::size_t, ZOB_ARRAY_SIZE> ZOB_ARRAY =
+            makeZobArray();
 
 /*
 Returns an index into ZOB_ARRAY that's unique to a specific
@@ -63,23 +82,6 @@ static std::size_t getZobIndex(std::size_t square_index, Piece piece) {
             + static_cast<std::size_t>(piece.color);
 }
 
-static std::vector<std::size_t> makeZobVec() {
-    // just assigns a random 64-bit value to every index
-    std::vector<std::size_t> zob_vec(
-            Square::NUM_SQUARES * NUM_TYPES * NUM_COLORS);
-    for (std::size_t isquare = 0; isquare < Square::NUM_SQUARES; ++isquare) {
-        for (std::size_t itype = 0; itype < NUM_TYPES; ++itype) {
-            for (std::size_t icolor = 0; icolor < NUM_COLORS; ++icolor) {
-                PieceType type = static_cast<PieceType>(itype);
-                PieceColor color = static_cast<PieceColor>(icolor);
-                std::size_t index = getZobIndex(isquare, Piece{type, color});
-                zob_vec[index] = util::getRand64();
-            }
-        }
-    }
-    return zob_vec;
-}
-
 /*
 Same as toggleZobPiece, but with "lower-level" parameters.
 Prevents zob_index (and/or square_index) recomputation.
@@ -101,3 +103,11 @@ std::size_t board::replaceZobPiece(std::size_t hash, Piece old_piece,
     hash = toggleZobIndex(hash, zob_index_old);
     return toggleZobIndex(hash, zob_index_new);
 }
+
+std::size_t board::toggleZobSideToMove(std::size_t hash) {
+    return toggleZobIndex(hash, ZOB_SIDE_TO_MOVE_INDEX);
+}
+
+std::size_t board::applyZobSideToMove(std::size_t hash, PieceColor color) {
+    return (color == PieceColor::WHITE) ? toggleZobSideToMove(hash) : hash;
+}
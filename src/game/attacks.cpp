@@ -0,0 +1,332 @@
+// Copyright 2021 Alex Theimer
+
+#include "game/attacks.h"
+
+#include <array>
+#include <cstdint>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "util/assert.h"
+#include "util/bitops.h"
+
+using board::Bitboard;
+using board::Square;
+using board::SquareIndex;
+
+struct Diff {
+    int row_diff;
+    int col_diff;
+};
+
+/*
+################################################################################
+                        =============================
+                        =====  Step Attacks  ========
+                        =============================
+
+    Kings/pawns and knights attack a fixed set of squares regardless of
+    occupancy, so their tables are built entirely at compile-time.
+
+################################################################################
+*/
+
+static constexpr std::array<Diff, 8> KING_DIFFS = {{
+        {  1,  0 },
+        {  0,  1 },
+        {  1,  1 },
+        { -1,  0 },
+        {  0, -1 },
+        { -1, -1 },
+        {  1, -1 },
+        { -1,  1 }
+}};
+
+static constexpr std::array<Diff, 8> KNIGHT_DIFFS = {{
+        {  2,  1 },
+        {  2, -1 },
+        { -2,  1 },
+        { -2, -1 },
+        {  1,  2 },
+        {  1, -2 },
+        { -1,  2 },
+        { -1, -2 }
+}};
+
+/*
+Returns a table such that each square's entry contains every
+in-bounds square reached by adding one of the Diffs.
+
+Note: can't use Square here; its functions aren't constexpr.
+*/
+static constexpr std::array<Bitboard, Square::NUM_SQUARES> makeStepTable(
+                                        const std::array<Diff, 8>& diffs) {
+    constexpr int WIDTH = Square::MAX_DIM_VALUE;
+    std::array<Bitboard, Square::NUM_SQUARES> table = {};
+    for (int isquare = 0; isquare < static_cast<int>(Square::NUM_SQUARES);
+            ++isquare) {
+        for (Diff diff : diffs) {
+            int row = (isquare / WIDTH) + diff.row_diff;
+            int col = (isquare % WIDTH) + diff.col_diff;
+            if (row >= 0 && row < WIDTH && col >= 0 && col < WIDTH) {
+                table[isquare] |= static_cast<Bitboard>(1)
+                        << (row * WIDTH + col);
+            }
+        }
+    }
+    return table;
+}
+
+static constexpr std::array<Bitboard, Square::NUM_SQUARES> KING_TABLE =
+        makeStepTable(KING_DIFFS);
+static constexpr std::array<Bitboard, Square::NUM_SQUARES> KNIGHT_TABLE =
+        makeStepTable(KNIGHT_DIFFS);
+
+/*
+Returns the total number of attacked squares across an entire table.
+*/
+static constexpr std::size_t countTable(
+        const std::array<Bitboard, Square::NUM_SQUARES>& table) {
+    std::size_t count = 0;
+    for (Bitboard attacks : table) {
+        count += __builtin_popcountll(attacks);
+    }
+    return count;
+}
+
+// corners, edges, and center squares
+static_assert(KING_TABLE[0] == 0x0000000000000302ULL, "king at (0, 0)");
+static_assert(KING_TABLE[63] == 0x40C0000000000000ULL, "king at (7, 7)");
+static_assert(KING_TABLE[4] == 0x0000000000003828ULL, "king at (0, 4)");
+static_assert(KING_TABLE[27] == 0x0000001C141C0000ULL, "king at (3, 3)");
+static_assert(KNIGHT_TABLE[0] == 0x0000000000020400ULL, "knight at (0, 0)");
+static_assert(KNIGHT_TABLE[63] == 0x0020400000000000ULL, "knight at (7, 7)");
+static_assert(KNIGHT_TABLE[27] == 0x0000142200221400ULL, "knight at (3, 3)");
+// every (a, b) pair appears as (b, a), so totals count each edge twice
+static_assert(countTable(KING_TABLE) == 420, "total king attacks");
+static_assert(countTable(KNIGHT_TABLE) == 336, "total knight attacks");
+
+/*
+################################################################################
+                        =============================
+                        =====  Magic Bitboards  =====
+                        =============================
+
+    A slider's attacks depend only on the occupancy of the squares along
+    its rays (excluding the edge squares, which are attacked regardless of
+    whether they're occupied). For each square, every possible subset of
+    these "relevant" squares is mapped to a unique index of an attack table:
+
+        index = ((occupancy & mask) * magic) >> (64 - popcount(mask))
+
+    The magic numbers below were found by a (fixed-seed) random search such
+    that no two subsets with different attacks share an index.
+
+    When compiled for a CPU with BMI2 (i.e. Makefile flag BMI2=1), the
+    index is instead extracted directly via PEXT. The index space is
+    identical, so both variants use the same table layout.
+
+################################################################################
+*/
+
+// Everything needed to index into a square's slice of an attack table.
+struct MagicEntry {
+    Bitboard mask;
+    Bitboard magic;
+    unsigned shift;
+    Bitboard* attacks;
+};
+
+static constexpr std::array<Diff, 4> ROOK_DIFFS = {{
+        {  0,  1 },
+        {  1,  0 },
+        { -1,  0 },
+        {  0, -1 }
+}};
+
+static constexpr std::array<Diff, 4> BISHOP_DIFFS = {{
+        {  1,  1 },
+        {  1, -1 },
+        { -1,  1 },
+        { -1, -1 }
+}};
+
+static constexpr std::array<Bitboard, Square::NUM_SQUARES> ROOK_MAGICS = {{
+        0x1080004008801020ULL, 0x0840092002c03000ULL, 0x1900200010400900ULL,
+        0x0880100008000480ULL, 0x4200100420080200ULL, 0x8100020100080400ULL,
+        0x0200040110886200ULL, 0x0200008040220411ULL, 0x0404800084400220ULL,
+        0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+        0x000a001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL,
+        0x0442000102105084ULL, 0x9080010020804100ULL, 0x0040404000201009ULL,
+        0x0000808010002009ULL, 0x2200090021d00100ULL, 0x0008008008040080ULL,
+        0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000a0001768104ULL,
+        0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL,
+        0x1000100080080080ULL, 0x0442000a00049020ULL, 0x2100040080020080ULL,
+        0x0800120400900148ULL, 0x0010040a00128541ULL, 0x2800804000800030ULL,
+        0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+        0x0400802402800800ULL, 0xc100020080800400ULL, 0x0002000802000401ULL,
+        0x0182085882000401ULL, 0x0220204000808000ULL, 0x2860100040024022ULL,
+        0x0001002004110040ULL, 0x99101042000a0020ULL, 0x0004080004008080ULL,
+        0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+        0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040a00300ULL,
+        0x0801100280080480ULL, 0x0242009008200600ULL, 0x1002000489500200ULL,
+        0x0040800200010080ULL, 0x0091800041000080ULL, 0x0000209300488001ULL,
+        0x04c1002414824001ULL, 0x020020000b001041ULL, 0x7000100004200901ULL,
+        0x8002002004100802ULL, 0x30010002084c0007ULL, 0x0888221800813004ULL,
+        0x4000002840840112ULL
+}};
+
+static constexpr std::array<Bitboard, Square::NUM_SQUARES> BISHOP_MAGICS = {{
+        0xa010041108003100ULL, 0x006082020a002900ULL, 0x6810010619200000ULL,
+        0x08281a0520000408ULL, 0x0001104001000400ULL, 0x0018901008048400ULL,
+        0x00040a0210245280ULL, 0x000200210808a402ULL, 0x9140048410821200ULL,
+        0x0800091010820041ULL, 0x20504804832202c0ULL, 0x0100091401081000ULL,
+        0x8021011140000012ULL, 0x0810020804450400ULL, 0x208b0542109008a2ULL,
+        0x0080084a08040204ULL, 0x0040e2a80811244cULL, 0x2505022008008108ULL,
+        0x0430220100420040ULL, 0x010a040420220040ULL, 0x1105000290400000ULL,
+        0x0093001200822120ULL, 0x4000a62048043004ULL, 0x280120048a015004ULL,
+        0x006090002a020814ULL, 0x44042000240800d0ULL, 0x01102800040a4400ULL,
+        0x1004080080220040ULL, 0x0001001011004024ULL, 0x0010044000805040ULL,
+        0x0914041200820100ULL, 0x0004821012821480ULL, 0x0024040500c05021ULL,
+        0x0088611002080200ULL, 0x0116080a00040020ULL, 0x4000020080080080ULL,
+        0x2450450140840040ULL, 0x0000880201484100ULL, 0x0222020404020092ULL,
+        0x8081110600002e00ULL, 0x2842101105000801ULL, 0x1100809008001025ULL,
+        0x00020202221c0400ULL, 0x0422014022009020ULL, 0x0210046102100c00ULL,
+        0xc004008082029102ULL, 0x00aa461801101200ULL, 0x0404080080201108ULL,
+        0x020542108c205002ULL, 0x0410544804100100ULL, 0x0040910841100000ULL,
+        0x0400200042021100ULL, 0x00004204850400c0ULL, 0x0200100410a42102ULL,
+        0x1040020801210102ULL, 0x0805040410420000ULL, 0x2884804130100200ULL,
+        0x800c262201242000ULL, 0x1058000194108800ULL, 0x0014221054420204ULL,
+        0x0104000012a02200ULL, 0x0200881003300100ULL, 0x0140400202840100ULL,
+        0x0402020801010201ULL
+}};
+
+// Total number of attack sets stored for all squares (i.e. the sum of
+//     2^popcount(mask) across every square).
+static constexpr std::size_t ROOK_TABLE_SIZE = 102400;
+static constexpr std::size_t BISHOP_TABLE_SIZE = 5248;
+
+static Bitboard ROOK_TABLE[ROOK_TABLE_SIZE];
+static Bitboard BISHOP_TABLE[BISHOP_TABLE_SIZE];
+
+static MagicEntry ROOK_ENTRIES[Square::NUM_SQUARES];
+static MagicEntry BISHOP_ENTRIES[Square::NUM_SQUARES];
+
+/*
+Walks each ray from the square one step at a time.
+
+@param occupancy: each ray stops at the first occupied square.
+@param exclude_edges: if true, the final square of each ray is not included.
+*/
+static Bitboard slideAttacks(SquareIndex square_index, Bitboard occupancy,
+                             const std::array<Diff, 4>& diffs,
+                             bool exclude_edges) {
+    Square square = Square::indexToSquare(square_index);
+    Bitboard attacks = 0;
+    for (Diff diff : diffs) {
+        std::size_t row = square.row + diff.row_diff;
+        std::size_t col = square.col + diff.col_diff;
+        while (Square::isValidDims(row, col)) {
+            if (exclude_edges && !Square::isValidDims(row + diff.row_diff,
+                                                      col + diff.col_diff)) {
+                break;
+            }
+            Bitboard bit = static_cast<Bitboard>(1)
+                    << Square::squareToIndex(Square(row, col));
+            attacks |= bit;
+            if (occupancy & bit) {
+                break;
+            }
+            row += diff.row_diff;
+            col += diff.col_diff;
+        }
+    }
+    return attacks;
+}
+
+static std::size_t getMagicIndex(const MagicEntry& entry, Bitboard occupancy) {
+#ifdef __BMI2__
+    return _pext_u64(occupancy, entry.mask);
+#else
+    return ((occupancy & entry.mask) * entry.magic) >> entry.shift;
+#endif
+}
+
+/*
+Fills a slider's MagicEntries and attack table.
+@return: the number of table slots used.
+*/
+static std::size_t initMagics(const std::array<Bitboard,
+                                               Square::NUM_SQUARES>& magics,
+                              const std::array<Diff, 4>& diffs,
+                              MagicEntry* entries, Bitboard* table) {
+    Bitboard* next_slice = table;
+    for (std::size_t isquare = 0; isquare < Square::NUM_SQUARES; ++isquare) {
+        MagicEntry& entry = entries[isquare];
+        entry.mask = slideAttacks(isquare, 0, diffs, true);
+        entry.magic = magics[isquare];
+        entry.shift = util::NUM_BITOP_BITS - __builtin_popcountll(entry.mask);
+        entry.attacks = next_slice;
+
+        // step thru every subset of the mask (i.e. the "Carry-Rippler" trick)
+        Bitboard subset = 0;
+        do {
+            Bitboard attacks = slideAttacks(isquare, subset, diffs, false);
+            std::size_t index = getMagicIndex(entry, subset);
+            ASSERT(entry.attacks[index] == 0
+                   || entry.attacks[index] == attacks,
+                   "magic collision at square: " + std::to_string(isquare));
+            entry.attacks[index] = attacks;
+            subset = (subset - entry.mask) & entry.mask;
+        } while (subset != 0);
+
+        next_slice += static_cast<std::size_t>(1)
+                << __builtin_popcountll(entry.mask);
+    }
+    return next_slice - table;
+}
+
+/*
+Fills all attack tables; returns true when done.
+(Used to fill the tables at static initialization.)
+*/
+static bool initAttackTables() {
+    std::size_t rook_size = initMagics(ROOK_MAGICS, ROOK_DIFFS,
+                                       ROOK_ENTRIES, ROOK_TABLE);
+    std::size_t bishop_size = initMagics(BISHOP_MAGICS, BISHOP_DIFFS,
+                                         BISHOP_ENTRIES, BISHOP_TABLE);
+    ASSERT(rook_size == ROOK_TABLE_SIZE,
+            "rook table size: " + std::to_string(rook_size));
+    ASSERT(bishop_size == BISHOP_TABLE_SIZE,
+            "bishop table size: " + std::to_string(bishop_size));
+    return (rook_size == ROOK_TABLE_SIZE) && (bishop_size == BISHOP_TABLE_SIZE);
+}
+
+static const bool ATTACK_TABLES_INITIALIZED = initAttackTables();
+
+Bitboard game::getKingAttacks(SquareIndex square_index) {
+    return KING_TABLE[square_index];
+}
+
+Bitboard game::getKnightAttacks(SquareIndex square_index) {
+    return KNIGHT_TABLE[square_index];
+}
+
+Bitboard game::getRookAttacks(SquareIndex square_index, Bitboard occupancy) {
+    ASSERT(ATTACK_TABLES_INITIALIZED, "attack tables not initialized");
+    const MagicEntry& entry = ROOK_ENTRIES[square_index];
+    return entry.attacks[getMagicIndex(entry, occupancy)];
+}
+
+Bitboard game::getBishopAttacks(SquareIndex square_index, Bitboard occupancy) {
+    ASSERT(ATTACK_TABLES_INITIALIZED, "attack tables not initialized");
+    const MagicEntry& entry = BISHOP_ENTRIES[square_index];
+    return entry.attacks[getMagicIndex(entry, occupancy)];
+}
+
+Bitboard game::getQueenAttacks(SquareIndex square_index, Bitboard occupancy) {
+    return getRookAttacks(square_index, occupancy)
+         | getBishopAttacks(square_index, occupancy);
+}
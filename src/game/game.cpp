@@ -2,10 +2,12 @@
 
 #include "game/game.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
-#include <sstream>
+#include <vector>
 
+#include "board/zobhash.h"
 #include "util/buffer.h"
 #include "game/move.h"
 #include "util/assert.h"
@@ -19,8 +21,6 @@ using board::Board;
 using game::Game;
 using game::Player;
 
-constexpr PieceColor START_COLOR = PieceColor::BLACK;
-
 const std::unordered_map<Square, Piece> game::INIT_PIECE_MAP = {
         { Square(0, 0), Piece{ PieceType::ROOK, PieceColor::BLACK } },
         { Square(0, 1), Piece{ PieceType::KNIGHT, PieceColor::BLACK } },
@@ -62,20 +62,23 @@ const std::unordered_map<Square, Piece> game::INIT_PIECE_MAP = {
 };
 
 
-game::InvalidMoveEx::InvalidMoveEx(Move move) : move_(move) {
+game::InvalidMoveEx::InvalidMoveEx(Move move) :
+        move_(move), message_("invalid move: " + std::to_string(move)) {
     // intentionally blank
 }
 
 const char* game::InvalidMoveEx::what() const throw() {
-    std::stringstream ss;
-    ss << "invalid move: " << move_;
-    return ss.str().c_str();
+    return message_.c_str();
 }
 
 game::Move game::InvalidMoveEx::getMove() const {
     return move_;
 }
 
+std::size_t game::getPositionKey(const Board& board, PieceColor color) {
+    return board::applyZobSideToMove(std::hash<Board>{}(board), color);
+}
+
 game::Player::Player(std::string name) : name_(name) {
     // intentionally blank
 }
@@ -85,8 +88,15 @@ std::string game::Player::getName() {
 }
 
 Game::Game(Board* board, Player* white_player, Player* black_player) :
+        Game(board, white_player, black_player, START_COLOR) {
+    // intentionally blank
+}
+
+Game::Game(Board* board, Player* white_player, Player* black_player,
+           PieceColor next_color) :
         board_(board), white_player_(white_player),
-        black_player_(black_player), next_player_color_(START_COLOR) {
+        black_player_(black_player), next_player_color_(next_color),
+        history_(), is_drawn_(false) {
     // intentionally blank
 }
 
@@ -112,13 +122,24 @@ void Game::runPly() {
                 "unhandled PieceColor: " + std::to_string(current_color));
     }
     // get the move the player wants to make
-    Move move = player->getMove(*board_, current_color);
+    Move move = player->getMove(*board_, current_color, history_);
     // make sure the move is valid
-    if (game::isValidMove(*board_, current_color, move)) {
-        game::makeMove(board_, move);
-    } else {
+    if (!game::isValidMove(*board_, current_color, move)) {
         throw InvalidMoveEx(move);
     }
+    std::size_t key = game::getPositionKey(*board_, current_color);
+    game::UndoInfo undo_info = game::makeMove(board_,
+                                              game::compressMove(move));
+    // no position before a capture can occur again
+    if (undo_info.captured != board::EMPTY_COMPRESSED_PIECE) {
+        history_.clear();
+    } else {
+        history_.push_back(key);
+    }
+    key = game::getPositionKey(*board_, next_player_color_);
+    std::size_t num_occurrences =
+            1 + std::count(history_.begin(), history_.end(), key);
+    is_drawn_ = num_occurrences >= NUM_REPETITIONS_DRAW;
 }
 
 bool Game::isEnded() const {
@@ -126,11 +147,16 @@ bool Game::isEnded() const {
     util::Buffer<Square, 2> buffer;
     std::size_t size = board_->getOccupiedSquares(
             PieceType::KING, buffer.start());
-    return size < static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS);
+    return is_drawn_
+           || size < static_cast<std::size_t>(PieceColor::NUM_PIECE_COLORS);
+}
+
+bool Game::isDrawn() const {
+    return is_drawn_;
 }
 
 Player& Game::getWinner() const {
-    ASSERT(isEnded(), "game not yet ended");
+    ASSERT(isEnded() && !isDrawn(), "game not yet won");
     // get the color of the only remaining king; return that player.
     util::Buffer<Square, 2> buffer;
 
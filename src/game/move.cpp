@@ -5,208 +5,138 @@
 #include <map>
 #include <vector>
 #include <stdexcept>
-#include <array>
 #include <cmath>
 #include <sstream>
 #include <string>
 
+#include "game/attacks.h"
 #include "util/buffer.h"
+#include "util/bitops.h"
 #include "util/assert.h"
 
+using board::Bitboard;
 using board::Board;
 using board::PieceColor;
 using board::PieceType;
 using board::Square;
+using board::SquareIndex;
 using board::Piece;
 
 using game::Move;
-
-struct Diff {
-    int row_diff;
-    int col_diff;
-};
+using game::CompressedMove;
 
 /*
-Given an initial Square and array of Diffs, fills a buffer with all *valid*
-moves such that each destination Square is the sum of the initial Square
-with the Diff.
-
-A valid Move is any such that the destination:
-    (1) is within the Board's bounds, and
-    (2) does not contain a piece of the same color
+Note: compressed moves are built as follows:
+|-- flags (4) --|-- to index (6) --|-- from index (6) --|
+*/
+static constexpr std::size_t NUM_MOVE_INDEX_BITS = 6;
+static constexpr CompressedMove MOVE_INDEX_MASK =
+        (static_cast<CompressedMove>(1) << NUM_MOVE_INDEX_BITS) - 1;
+// mask of both the from/to bits (i.e. everything except the flags)
+static constexpr CompressedMove MOVE_SQUARES_MASK =
+        (static_cast<CompressedMove>(1) << (2 * NUM_MOVE_INDEX_BITS)) - 1;
+static_assert((static_cast<std::size_t>(1) << NUM_MOVE_INDEX_BITS)
+                  == Square::NUM_SQUARES,
+              "NUM_MOVE_INDEX_BITS must be log2(NUM_SQUARES)");
+static_assert((game::MOVE_FLAG_CAPTURE & MOVE_SQUARES_MASK) == 0,
+              "flags must not overlap the from/to bits");
 
-@param color: the color of the piece at the Square
-@param buffer: a random-access iterator at the first index of the buffer
-@return: the number of Moves added to the buffer
+/*
+Packs from/to indices and flags into a CompressedMove.
 */
-template <typename RandomAccessIter, std::size_t SIZE>
-std::size_t getMovesDiff(const Board& board, PieceColor color, Square square,
-                         const std::array<Diff, SIZE>& diffs,
-                         RandomAccessIter buffer) {
-    std::size_t i = 0;
-    for (Diff diff : diffs) {
-        std::size_t row = square.row + diff.row_diff;
-        std::size_t col = square.col + diff.col_diff;
-        // add to the buffer if (1) in-bounds and (2) unoccupied by same color
-        if (Square::isValidDims(row, col)) {
-            Square new_square(row, col);
-            if (!board.squareIsOccupiedColor(new_square, color)) {
-                Move move = { square, new_square };
-                buffer[i] = move;
-                ++i;
-            }
-        }
-    }
-    return i;
+static CompressedMove makeCompressedMove(std::size_t from_index,
+                                         std::size_t to_index,
+                                         CompressedMove flags) {
+    return static_cast<CompressedMove>(
+            from_index | (to_index << NUM_MOVE_INDEX_BITS) | flags);
 }
 
 /*
-Given an initial Square and array of Diffs, fills a buffer with all *valid*
-moves such that each destination Square is the sum of the initial Square with a
-positive multiple of a Diff in the array.
-
-For each Diff, Moves are generated with each coefficient
-[1, 2, 3...] in increasing order until the first invalid Move is generated.
-
-A valid Move is any such that the destination:
-    (1) is within the Board's bounds, and
-    (2) does not contain a piece of the same color
-
-@param color: the color of the piece at the Square
+Fills a buffer with a CompressedMove from `from_index` to each Square that
+contains a 1 on the Bitboard. Moves onto `enemies` are flagged as captures.
 @param buffer: a random-access iterator at the first index of the buffer
 @return: the number of Moves added to the buffer
 */
-template <typename RandomAccessIter, std::size_t SIZE>
-std::size_t getMovesVector(const Board& board, PieceColor color, Square square,
-                           const std::array<Diff, SIZE>& vectors,
-                           RandomAccessIter buffer) {
+template <typename RandomAccessIter>
+std::size_t bitboardToMoves(SquareIndex from_index, Bitboard targets,
+                            Bitboard enemies, RandomAccessIter buffer) {
     RandomAccessIter begin = buffer;
-    for (Diff vec : vectors) {
-        // TODO(theimer): worth changing the spec for this?
-//        ASSERT((std::abs(vec.row_diff) <= 1) && (std::abs(vec.col_diff) <= 1),
-//                "expected diffs <= 1; got: (" + std::to_string(vec.col_diff)
-//                + ", " + std::to_string(vec.row_diff) +")");
-        Square curr_sq = square;
-        // keep adding multiples to each vec until an invalid square is reached.
-        while (true) {
-            std::size_t new_row = curr_sq.row + vec.row_diff;
-            if (new_row >= Board::WIDTH) {
-                break;
-            }
-            std::size_t new_col = curr_sq.col + vec.col_diff;
-            if (new_col >= Board::WIDTH) {
-                break;
-            }
-            curr_sq = Square(new_row, new_col);
-            if (!board.squareIsOccupied(curr_sq)) {
-                // square is empty!
-                *buffer = Move{ square, curr_sq };
-                ++buffer;
-            } else if (!board.squareIsOccupiedColor(curr_sq, color)) {
-                // square occupied by enemy
-                *buffer = Move{ square, curr_sq };
-                ++buffer;
-                break;
-            } else {
-                // occupied by friendly!
-                // jumps not allowed, so we're done with this Diff
-                break;
-            }
-        }
+    while (targets > 0) {
+        std::size_t to_index = util::popLowestBit(&targets);
+        CompressedMove flags = util::getBit(enemies, to_index)
+                             ? game::MOVE_FLAG_CAPTURE : 0;
+        *buffer = makeCompressedMove(from_index, to_index, flags);
+        ++buffer;
     }
     return buffer - begin;
 }
 
 /*
-Fills a buffer with all valid moves by a king or pawn.
-*/
-template<typename RandomAccessIter>
-std::size_t getMovesPawnKing(const Board& board, PieceColor color,
-                             Square square, RandomAccessIter buffer) {
-    static const std::array<Diff, 8> diffs = {{
-            {  1,  0 },
-            {  0,  1 },
-            {  1,  1 },
-            { -1,  0 },
-            {  0, -1 },
-            { -1, -1 },
-            {  1, -1 },
-            { -1,  1 }
-    }};
-
-    return getMovesDiff(board, color, square, diffs, buffer);
-}
-
-/*
-Fills a buffer with all valid moves by a knight.
-*/
-template<typename RandomAccessIter>
-std::size_t getMovesKnight(const Board& board, PieceColor color,
-                           Square square, RandomAccessIter buffer) {
-    static const std::array<Diff, 8> diffs = {{
-            {  2,  1 },
-            {  2, -1 },
-            { -2,  1 },
-            { -2, -1 },
-            {  1,  2 },
-            {  1, -2 },
-            { -1,  2 },
-            { -1, -2 }
-    }};
-
-    return getMovesDiff(board, color, square, diffs, buffer);
-}
-
-/*
-Fills a buffer with all valid moves by a rook.
+Fills a buffer with the moves of a king, pawn, or knight, given its
+attack lookup.
+@param target_mask: only moves onto these squares are generated; must not
+                    include squares occupied by the same color.
+@param enemies: squares occupied by the opposite color
 */
-template<typename RandomAccessIter>
-std::size_t getMovesRook(const Board& board, PieceColor color,
-                         Square square, RandomAccessIter buffer) {
-    static const std::array<Diff, 4> vectors = {{
-            Diff{  0,  1 },
-            Diff{  1,  0 },
-            Diff{ -1,  0 },
-            Diff{  0, -1 },
-    }};
-
-    return getMovesVector(board, color, square, vectors, buffer);
+template <typename RandomAccessIter>
+std::size_t getMovesStep(SquareIndex index,
+                         Bitboard (*get_attacks)(SquareIndex),
+                         Bitboard target_mask, Bitboard enemies,
+                         RandomAccessIter buffer) {
+    Bitboard targets = get_attacks(index) & target_mask;
+    return bitboardToMoves(index, targets, enemies, buffer);
 }
 
 /*
-Fills a buffer with all valid moves by a bishop.
+Fills a buffer with the moves of a slider, given its attack lookup.
+@param target_mask: only moves onto these squares are generated; must not
+                    include squares occupied by the same color.
+@param enemies: squares occupied by the opposite color
 */
-template<typename RandomAccessIter>
-std::size_t getMovesBishop(const Board& board, PieceColor color,
-                           Square square, RandomAccessIter buffer) {
-    static const std::array<Diff, 4> vectors = {{
-            Diff{  1,  1 },
-            Diff{  1, -1 },
-            Diff{ -1,  1 },
-            Diff{ -1, -1 },
-    }};
-
-    return getMovesVector(board, color, square, vectors, buffer);
+template <typename RandomAccessIter>
+std::size_t getMovesSlider(const Board& board, SquareIndex index,
+                           Bitboard (*get_attacks)(SquareIndex, Bitboard),
+                           Bitboard target_mask, Bitboard enemies,
+                           RandomAccessIter buffer) {
+    Bitboard targets = get_attacks(index, board.getOccupancyBitboard())
+                     & target_mask;
+    return bitboardToMoves(index, targets, enemies, buffer);
 }
 
 /*
-Fills a buffer with all valid moves by a queen.
+Fills a buffer with the moves of the Piece at the specified index.
+(i.e. getPieceMoves without the Square -> index conversion.)
+@param target_mask: only moves onto these squares are generated; must not
+                    include squares occupied by the same color.
 */
 template<typename RandomAccessIter>
-std::size_t getMovesQueen(const Board& board, PieceColor color,
-                          Square square, RandomAccessIter buffer) {
-    static const std::array<Diff, 8> vectors = {{
-            Diff{  1,  1 },
-            Diff{  1, -1 },
-            Diff{ -1,  1 },
-            Diff{ -1, -1 },
-            Diff{  0,  1 },
-            Diff{  1,  0 },
-            Diff{ -1,  0 },
-            Diff{  0, -1 },
-    }};
-
-    return getMovesVector(board, color, square, vectors, buffer);
+std::size_t getPieceMovesIndex(const Board& board, PieceColor color,
+                               SquareIndex index, Bitboard target_mask,
+                               RandomAccessIter buffer) {
+    Bitboard enemies = board.getColorBitboard(board::oppositeColor(color));
+    // TODO(theimer): better to just map function pointers?
+    PieceType type = board.getPieceType(Square::indexToSquare(index));
+    switch (type) {
+    case PieceType::PAWN:
+    case PieceType::KING:
+        return getMovesStep(index, &game::getKingAttacks,
+                            target_mask, enemies, buffer);
+    case PieceType::BISHOP:
+        return getMovesSlider(board, index, &game::getBishopAttacks,
+                              target_mask, enemies, buffer);
+    case PieceType::KNIGHT:
+        return getMovesStep(index, &game::getKnightAttacks,
+                            target_mask, enemies, buffer);
+    case PieceType::QUEEN:
+        return getMovesSlider(board, index, &game::getQueenAttacks,
+                              target_mask, enemies, buffer);
+    case PieceType::ROOK:
+        return getMovesSlider(board, index, &game::getRookAttacks,
+                              target_mask, enemies, buffer);
+    default:
+        throw std::invalid_argument(
+                "unhandled PieceType: " + std::to_string(type));
+    }
 }
 
 std::string std::to_string(game::Move move) {
@@ -225,92 +155,109 @@ std::ostream& game::operator<<(std::ostream& out, Move move) {
     return out;
 }
 
+CompressedMove game::compressMove(Move move) {
+    return makeCompressedMove(Square::squareToIndex(move.from),
+                              Square::squareToIndex(move.to), 0);
+}
+
+Move game::decompressMove(CompressedMove compressed_move) {
+    return Move{ Square::indexToSquare(getMoveFromIndex(compressed_move)),
+                 Square::indexToSquare(getMoveToIndex(compressed_move)) };
+}
+
+SquareIndex game::getMoveFromIndex(CompressedMove compressed_move) {
+    return compressed_move & MOVE_INDEX_MASK;
+}
+
+SquareIndex game::getMoveToIndex(CompressedMove compressed_move) {
+    return (compressed_move >> NUM_MOVE_INDEX_BITS) & MOVE_INDEX_MASK;
+}
+
+bool game::isCaptureMove(CompressedMove compressed_move) {
+    return (compressed_move & MOVE_FLAG_CAPTURE) != 0;
+}
+
+bool game::isSameMove(CompressedMove lhs, CompressedMove rhs) {
+    return ((lhs ^ rhs) & MOVE_SQUARES_MASK) == 0;
+}
+
+/*
+Fills a buffer with the moves of every Piece of the specified color.
+@param target_mask: only moves onto these squares are generated; must not
+                    include squares occupied by the same color.
+*/
+template<typename RandomAccessIter>
+std::size_t getAllMovesMasked(const Board& board, PieceColor color,
+                              Bitboard target_mask, RandomAccessIter buffer) {
+    // step thru all occupied squares; get the valid moves from each
+    Bitboard occupied = board.getColorBitboard(color);
+    RandomAccessIter next_move_slot = buffer;
+    while (occupied > 0) {
+        SquareIndex index = util::popLowestBit(&occupied);
+        next_move_slot += getPieceMovesIndex(board, color, index, target_mask,
+                                             next_move_slot);
+    }
+    return next_move_slot - buffer;
+}
+
 template<typename RandomAccessIter>
 std::size_t game::getPieceMoves(const Board& board, PieceColor color,
                                 Square square, RandomAccessIter buffer) {
-    // TODO(theimer): better to just map function pointers?
-    PieceType type = board.getPieceType(square);
-    switch (type) {
-    case PieceType::PAWN:
-    case PieceType::KING:
-        return getMovesPawnKing(board, color, square, buffer);
-    case PieceType::BISHOP:
-        return getMovesBishop(board, color, square, buffer);
-    case PieceType::KNIGHT:
-        return getMovesKnight(board, color, square, buffer);
-    case PieceType::QUEEN:
-        return getMovesQueen(board, color, square, buffer);
-    case PieceType::ROOK:
-        return getMovesRook(board, color, square, buffer);
-    default:
-        throw std::invalid_argument(
-                "unhandled PieceType: " + std::to_string(type));
-    }
+    return getPieceMovesIndex(board, color, Square::squareToIndex(square),
+                              ~board.getColorBitboard(color), buffer);
 }
 
 template<typename RandomAccessIter>
 std::size_t game::getAllMoves(const Board& board, PieceColor color,
                               RandomAccessIter buffer) {
-    // get all occupied squares, then get the valid moves from those squares
-    util::Buffer<Square, Board::SIZE> occupied_buffer;
-    std::size_t num_occupied =
-            board.getOccupiedSquares(color, occupied_buffer.start());
-    RandomAccessIter next_move_slot = buffer;
-    for (std::size_t i = 0; i < num_occupied; ++i) {
-        next_move_slot += getPieceMoves(
-                board, color, occupied_buffer.get(i), next_move_slot);
-    }
-    return next_move_slot - buffer;
+    return getAllMovesMasked(board, color, ~board.getColorBitboard(color),
+                             buffer);
 }
 
-// TODO(theimer): board->index recomputation below!
-// TODO(theimer): these are super inefficient in-general
-
-std::optional<Piece> game::makeMove(Board* board, Move move) {
-    ASSERT(board->squareIsOccupied(move.from),
-            "unoccupied square: " + std::to_string(move.from));
-    // make sure move.to is unoccupied / occupied by a different color.
-    ASSERT(!board->squareIsOccupiedColor(
-                move.to, board->getPieceColor(move.from)),
-           "to square occupied by same color: " + std::to_string(move));
-    // I really don't want an "empty" PieceType and PieceColor, but
-    //     those might be more efficient than optioanls...
-    std::optional<Piece> removed = board->squareIsOccupied(move.to)
-                                 ? std::make_optional(board->getPiece(move.to))
-                                 : std::optional<Piece>();
-    board->movePieceOverwrite(move.from, move.to);
-    return removed;
+template<typename RandomAccessIter>
+std::size_t game::getAllCaptures(const Board& board, PieceColor color,
+                                 RandomAccessIter buffer) {
+    return getAllMovesMasked(
+            board, color,
+            board.getColorBitboard(board::oppositeColor(color)), buffer);
 }
 
-void game::unmakeMove(Board* board, Move move,
-                      std::optional<Piece> replacement) {
-    ASSERT(board->squareIsOccupied(move.to),
-            "unoccupied square: " + std::to_string(move.to));
-    ASSERT(!board->squareIsOccupied(move.from),
-            "occupied square: " + std::to_string(move.from));
+template<typename RandomAccessIter>
+std::size_t game::getAllQuiets(const Board& board, PieceColor color,
+                               RandomAccessIter buffer) {
+    return getAllMovesMasked(board, color, ~board.getOccupancyBitboard(),
+                             buffer);
+}
 
-    // make sure no residual "if" left over in non-debug compilation
-    #ifdef DEBUG
-    if (replacement.has_value()) {
-        ASSERT(board->getPieceColor(move.to) != replacement->color,
-                "piece has same color as replacement: "
-                + std::to_string(move.to));
-    }
-    # endif
+// These are used outside this file; instantiate them explicitly so they
+//     never depend on whether the compiler happened to emit them here.
+template std::size_t game::getPieceMoves<CompressedMove*>(
+        const Board& board, PieceColor color, Square square,
+        CompressedMove* buffer);
+template std::size_t game::getAllMoves<CompressedMove*>(
+        const Board& board, PieceColor color, CompressedMove* buffer);
+template std::size_t game::getAllCaptures<CompressedMove*>(
+        const Board& board, PieceColor color, CompressedMove* buffer);
+template std::size_t game::getAllQuiets<CompressedMove*>(
+        const Board& board, PieceColor color, CompressedMove* buffer);
+
+game::UndoInfo game::makeMove(Board* board, CompressedMove move) {
+    board::CompressedPiece captured = board->movePieceCapture(
+            getMoveFromIndex(move), getMoveToIndex(move));
+    return UndoInfo{ captured };
+}
 
-    // note: not "overwrite" because unmaking a move should move
-    //       a piece into an empty square
-    board->movePiece(move.to, move.from);
-    if (replacement.has_value()) {
-        board->setPiece(*replacement, move.to);
-    }
+void game::unmakeMove(Board* board, CompressedMove move, UndoInfo undo_info) {
+    board->unmovePieceCapture(getMoveFromIndex(move), getMoveToIndex(move),
+                              undo_info.captured);
 }
 
 bool game::isValidMove(const Board& board, PieceColor color, Move move) {
-    util::Buffer<Move, MAX_NUM_MOVES_PLY> move_buffer;
+    CompressedMove compressed_move = compressMove(move);
+    util::Buffer<CompressedMove, MAX_NUM_MOVES_PLY> move_buffer;
     std::size_t num_moves = getAllMoves(board, color, move_buffer.start());
     for (std::size_t i = 0; i < num_moves; ++i) {
-        if (move == move_buffer.get(i)) {
+        if (isSameMove(compressed_move, move_buffer.get(i))) {
             return true;
         }
     }
@@ -1,23 +1,198 @@
 // Copyright 2021 Alex Theimer
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "board/board.h"
 #include "game/game.h"
+#include "game/move.h"
 #include "player/human.h"
+#include "player/computer/book.h"
 #include "player/computer/computer.h"
 #include "util/assert.h"
-#include "util/macro.h"
 
+// the default depth of `chess bench`
+static constexpr std::size_t BENCH_DEPTH = 9;
+
+/*
+The positions searched by `chess bench`, as recorded games from the
+initial position (see player::computer::parseGameRecord), from the
+opening through to the endgame.
+*/
+static const char* const BENCH_POSITIONS[] = {
+    // after 0 plies
+    "",
+    // after 8 plies
+    "1 6 2 5 6 5 5 4 1 7 1 6 6 2 5 2 1 0 2 1 5 2 5 3 1 6 2 7 6 4 5 5",
+    // after 16 plies
+    "1 1 2 2 6 2 5 1 2 2 2 1 5 1 6 2 1 3 2 4 6 4 5 4 1 5 2 5 7 5 5 3 "
+    "0 4 3 7 6 3 5 2 3 7 2 6 7 1 6 3 2 6 6 6 5 3 7 5 6 6 5 7 6 7 5 7",
+    // after 24 plies
+    "1 5 2 6 6 6 5 5 0 6 2 7 7 1 5 0 1 1 2 2 6 2 5 1 2 2 3 2 6 0 7 1 "
+    "1 3 2 3 5 1 4 1 1 2 2 2 4 1 3 2 0 4 1 5 3 2 2 3 2 6 3 6 5 5 5 6 "
+    "0 3 1 2 6 3 5 3 0 2 3 5 7 2 3 6 1 2 2 3 3 6 2 7 3 5 5 3 7 6 5 5",
+    // after 32 plies
+    "1 1 2 0 6 2 5 3 0 6 2 7 5 3 6 2 1 6 0 6 6 6 5 5 1 2 2 1 6 1 5 0 "
+    "1 3 2 2 6 0 6 1 2 2 3 2 6 3 5 4 0 1 2 2 6 5 5 6 2 7 4 6 5 0 4 1 "
+    "4 6 6 7 5 6 6 7 2 0 3 0 7 0 3 0 1 5 2 5 3 0 3 2 2 5 3 5 3 2 3 5 "
+    "1 0 1 1 3 5 0 5 1 7 1 6 6 2 5 2 1 4 1 5 6 1 5 0 2 2 4 1 5 4 4 4",
+    // after 48 plies
+    "0 1 2 0 6 4 5 5 1 7 2 7 5 5 5 4 0 0 0 1 7 5 2 0 1 2 2 2 2 0 7 5 "
+    "1 3 2 4 7 6 5 7 2 7 3 6 7 5 3 1 3 6 4 7 6 3 5 3 2 2 3 2 6 5 5 6 "
+    "4 7 5 6 7 7 7 6 0 7 4 7 6 7 5 6 0 4 3 1 5 6 4 7 1 4 1 3 5 7 4 5 "
+    "1 3 2 3 5 4 6 4 3 2 3 3 4 5 3 3 2 4 3 3 7 4 4 1 3 1 5 3 4 1 1 1 "
+    "3 3 2 4 1 1 4 1 1 5 1 4 4 1 4 0 5 3 6 2 6 0 5 1 6 2 2 6 4 0 1 0 "
+    "2 3 3 2 1 0 1 4 0 5 1 4 4 7 5 7 2 6 3 6 7 2 3 6 1 6 1 5 3 6 7 2",
+    // after 64 plies
+    "1 3 2 4 6 4 5 4 1 4 2 5 7 5 5 3 0 6 1 4 5 3 1 7 1 5 0 6 1 7 0 6 "
+    "1 6 0 6 6 6 5 7 0 7 5 7 6 5 6 4 0 3 1 3 6 7 5 7 0 4 2 6 5 7 4 7 "
+    "2 6 6 2 6 1 6 2 0 1 2 0 6 4 7 5 2 4 3 4 7 7 6 7 3 4 4 4 5 4 4 4 "
+    "1 3 2 4 6 2 5 3 1 2 2 1 6 7 6 6 2 1 3 0 6 6 0 6 1 4 0 6 7 6 6 4 "
+    "0 0 0 1 4 4 4 3 1 1 2 1 7 1 5 0 0 5 3 2 5 3 6 2 3 2 5 0 6 2 5 2 "
+    "2 5 2 6 4 7 5 7 2 6 1 6 6 0 5 0 0 6 2 7 7 4 5 6 2 7 3 5 5 6 2 6 "
+    "1 6 2 6 4 3 5 3 3 5 2 7 5 0 6 0 2 4 2 3 5 3 6 2 2 6 2 5 5 7 5 6 "
+    "0 2 1 1 6 2 5 3 2 7 0 6 5 3 4 2 0 6 2 7 6 0 5 0 1 1 4 4 4 2 5 1",
+    // after 96 plies
+    "1 2 2 2 7 1 5 0 2 2 3 1 5 0 3 1 1 3 2 2 3 1 1 0 2 2 2 1 1 0 3 1 "
+    "0 4 3 1 6 2 5 2 0 2 4 6 6 3 6 2 3 1 6 1 5 2 6 1 2 1 3 1 6 4 6 3 "
+    "3 1 2 1 6 2 7 1 1 4 2 3 6 1 5 0 2 3 3 4 7 4 3 4 1 7 2 7 3 4 0 1 "
+    "1 6 2 5 0 1 0 0 0 3 1 4 6 7 5 7 1 4 0 4 7 2 6 1 1 1 1 0 7 5 5 3 "
+    "1 0 0 0 5 7 4 6 1 5 2 4 7 3 6 4 2 7 1 7 7 1 7 2 2 1 1 2 6 1 2 5 "
+    "2 4 2 5 6 4 7 5 0 5 5 0 6 0 5 0 0 4 0 5 6 3 6 2 1 7 1 6 7 7 0 7 "
+    "1 2 1 3 4 6 5 7 2 5 1 5 5 7 4 7 1 5 0 4 0 7 0 6 0 4 1 5 5 3 3 5 "
+    "1 5 0 6 7 6 6 4 0 0 1 1 5 0 5 1 1 1 2 0 7 2 7 3 1 6 1 5 3 5 1 7 "
+    "0 6 1 7 7 0 2 0 1 3 0 2 5 1 4 0 0 5 1 4 6 5 5 5 1 4 0 5 2 0 2 6 "
+    "0 5 0 6 6 2 6 3 1 5 0 5 2 6 1 6 0 6 0 7 4 7 4 6 0 7 1 6 4 0 3 0 "
+    "1 6 2 7 4 6 3 7 0 5 1 4 5 5 6 5 2 7 3 7 6 6 7 6 0 2 1 1 7 6 6 7 "
+    "3 7 3 6 6 4 4 5 3 6 4 5 7 3 6 4 4 5 5 5 3 0 4 1 1 1 0 2 6 4 7 4",
+};
+
+/*
+Searches each of BENCH_POSITIONS to a fixed depth with a single thread
+and a fresh transposition table, breaking ties between root moves
+deterministically, so the total node count is a signature of the
+search: any change to it (at the same hash size) is a change in the
+search's behavior. Prints the nodes of each position, then the total
+nodes, time, and NPS.
+*/
+static void runBench(std::size_t depth, std::size_t hash_size_mib) {
+    player::computer::SearchLimits limits{
+            depth, std::chrono::milliseconds::zero(),
+            std::chrono::milliseconds::zero(), 0 };
+    std::size_t total_nodes = 0;
+    std::chrono::microseconds total_elapsed(0);
+    std::size_t num_positions = sizeof(BENCH_POSITIONS)
+                                / sizeof(BENCH_POSITIONS[0]);
+    for (std::size_t i = 0; i < num_positions; ++i) {
+        board::Board board(game::INIT_PIECE_MAP);
+        board::PieceColor color = game::START_COLOR;
+        for (const game::Move& move :
+                player::computer::parseGameRecord(BENCH_POSITIONS[i])) {
+            ASSERT(game::isValidMove(board, color, move),
+                   "invalid bench position");
+            game::makeMove(&board, game::compressMove(move));
+            color = board::oppositeColor(color);
+        }
+
+        player::Computer player("bench", 1, hash_size_mib, false, limits,
+                                player::computer::DEFAULT_PRUNING_PARAMS,
+                                nullptr, nullptr);
+        player.getMove(board, color, {});
+        const player::computer::SearchStats& stats =
+                player.getLastSearchStats();
+        std::cout << "position " << (i + 1) << "/" << num_positions
+                  << ": " << stats.total.num_nodes << " nodes" << std::endl;
+        total_nodes += stats.total.num_nodes;
+        total_elapsed += stats.elapsed;
+    }
+
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            total_elapsed);
+    std::cout << "nodes: " << total_nodes << std::endl;
+    std::cout << "time: " << elapsed_ms.count() << " ms" << std::endl;
+    std::cout << "nps: " << (total_nodes * 1000000
+                             / std::max<std::int64_t>(1,
+                                     total_elapsed.count()))
+              << std::endl;
+}
+
+/*
+Usage: chess [--book book_path] [--tablebases directory] [--hash mib]
+       chess bench [depth [mib]]
+    book_path: an opening book (see tools/makebook.cpp) for both players.
+    directory: endgame tablebases (see tools/maketb.cpp) for both players.
+    mib: the transposition table size of each player, in MiB
+         (default player::DEFAULT_HASH_SIZE_MIB).
+    bench: searches a built-in set of positions to `depth` (default
+           BENCH_DEPTH) and prints the total nodes, time, and NPS.
+*/
 int main(int argc, char *argv[]) {
-    UNUSED(argc);
-    UNUSED(argv);
+    if (argc >= 2 && std::string(argv[1]) == "bench" && argc <= 4) {
+        std::size_t depth = (argc >= 3) ? std::strtoul(argv[2], nullptr, 10)
+                                        : BENCH_DEPTH;
+        std::size_t hash_size_mib = (argc == 4)
+                ? std::strtoul(argv[3], nullptr, 10)
+                : player::DEFAULT_HASH_SIZE_MIB;
+        if (depth < 1 || depth > player::computer::MAX_SEARCH_DEPTH) {
+            std::cerr << "depth must be in [1, "
+                      << player::computer::MAX_SEARCH_DEPTH << "]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (hash_size_mib < 1) {
+            std::cerr << "hash size must be at least 1 MiB" << std::endl;
+            return EXIT_FAILURE;
+        }
+        runBench(depth, hash_size_mib);
+        return 0;
+    }
+
+    std::unique_ptr<player::computer::OpeningBook> book;
+    std::unique_ptr<player::computer::Tablebases> tablebases;
+    std::size_t hash_size_mib = player::DEFAULT_HASH_SIZE_MIB;
+    for (int i = 1; i < argc; ++i) {
+        std::string option(argv[i]);
+        if (option == "--book" && i + 1 < argc) {
+            book = std::make_unique<player::computer::OpeningBook>(argv[++i]);
+        } else if (option == "--tablebases" && i + 1 < argc) {
+            tablebases = std::make_unique<player::computer::Tablebases>(
+                    argv[++i]);
+        } else if (option == "--hash" && i + 1 < argc
+                   && std::strtoul(argv[i + 1], nullptr, 10) > 0) {
+            hash_size_mib = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--book book_path]"
+                      << " [--tablebases directory] [--hash mib]"
+                      << std::endl;
+            std::cerr << "       " << argv[0] << " bench [depth [mib]]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
 
     board::Board board(game::INIT_PIECE_MAP);
-    player::Computer player1("RoboJim9000"), player2("RoboTim9000");
+    // the players take turns, so each may use every core
+    std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    // each move gets ~50ms (200ms at worst)
+    player::computer::SearchLimits limits{ player::computer::MAX_SEARCH_DEPTH,
+                                           std::chrono::milliseconds(50),
+                                           std::chrono::milliseconds(200), 0 };
+    player::Computer player1("RoboJim9000", num_threads, hash_size_mib,
+                             true, limits,
+                             player::computer::DEFAULT_PRUNING_PARAMS,
+                             book.get(), tablebases.get());
+    player::Computer player2("RoboTim9000", num_threads, hash_size_mib,
+                             true, limits,
+                             player::computer::DEFAULT_PRUNING_PARAMS,
+                             book.get(), tablebases.get());
     game::Game game(&board, &player1, &player2);
 
     std::srand(std::time(NULL));
@@ -27,6 +202,10 @@ int main(int argc, char *argv[]) {
         game.runPly();
     }
 
+    if (game.isDrawn()) {
+        std::cout << "Draw by repetition!" << std::endl;
+        return 0;
+    }
     game::Player& winner = game.getWinner();
     std::cout << winner.getName() << " wins!" << std::endl;
 }
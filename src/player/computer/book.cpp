@@ -0,0 +1,189 @@
+// Copyright 2021 Alex Theimer
+
+#include "player/computer/book.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "game/game.h"
+#include "util/rand.h"
+
+using board::Board;
+using board::PieceColor;
+using board::Square;
+using game::CompressedMove;
+using game::Move;
+using player::computer::BookEntry;
+using player::computer::BookHeader;
+using player::computer::OpeningBook;
+using player::computer::OpeningBookBuilder;
+
+// identifies (this version of) the book format
+static constexpr char BOOK_MAGIC[8] = { 'C', 'H', 'E', 'S', 'S', 'B', 'K',
+                                         '1' };
+
+uint64_t player::computer::getBookKey(const Board& board, PieceColor color) {
+    return game::getPositionKey(board, color);
+}
+
+std::vector<Move> player::computer::parseGameRecord(
+        const std::string& record) {
+    std::istringstream stream(record);
+    std::vector<Move> moves;
+    std::size_t row_from, col_from, row_to, col_to;
+    while (stream >> row_from) {
+        if (!(stream >> col_from >> row_to >> col_to)) {
+            throw std::invalid_argument("incomplete move in record: "
+                                        + record);
+        }
+        if (!Square::isValidDims(row_from, col_from)
+                || !Square::isValidDims(row_to, col_to)) {
+            throw std::invalid_argument("invalid square in record: " + record);
+        }
+        moves.push_back(Move{ Square(row_from, col_from),
+                              Square(row_to, col_to) });
+    }
+    if (!stream.eof()) {
+        throw std::invalid_argument("could not parse record: " + record);
+    }
+    return moves;
+}
+
+OpeningBook::OpeningBook(const std::string& path) :
+        file_(path), entries_(nullptr), num_entries_(0) {
+    if (file_.size() < sizeof(BookHeader)) {
+        throw std::runtime_error("not a book: " + path);
+    }
+    const BookHeader* header = reinterpret_cast<const BookHeader*>(
+            file_.data());
+    // (divides, since a corrupt num_entries could overflow a product)
+    std::size_t entries_size = file_.size() - sizeof(BookHeader);
+    if (std::memcmp(header->magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0
+            || entries_size % sizeof(BookEntry) != 0
+            || header->num_entries != entries_size / sizeof(BookEntry)) {
+        throw std::runtime_error("not a book: " + path);
+    }
+    num_entries_ = header->num_entries;
+    entries_ = reinterpret_cast<const BookEntry*>(header + 1);
+}
+
+std::size_t OpeningBook::size() const {
+    return num_entries_;
+}
+
+std::size_t OpeningBook::getEntries(const Board& board, PieceColor color,
+                                    const BookEntry** entries) const {
+    uint64_t key = player::computer::getBookKey(board, color);
+    const BookEntry* end = entries_ + num_entries_;
+    const BookEntry* first = std::lower_bound(entries_, end, key,
+            [](const BookEntry& entry, uint64_t key) {
+        return entry.key < key;
+    });
+    const BookEntry* last = first;
+    while (last != end && last->key == key) {
+        ++last;
+    }
+    if (first != last) {
+        *entries = first;
+    }
+    return last - first;
+}
+
+CompressedMove OpeningBook::pickMove(const Board& board,
+                                     PieceColor color) const {
+    const BookEntry* entries;
+    std::size_t num_entries = getEntries(board, color, &entries);
+    std::vector<const BookEntry*> valid;
+    uint64_t total_weight = 0;
+    for (std::size_t i = 0; i < num_entries; ++i) {
+        if (entries[i].weight > 0
+                && game::isValidMove(board, color,
+                                     game::decompressMove(entries[i].move))) {
+            valid.push_back(&entries[i]);
+            total_weight += entries[i].weight;
+        }
+    }
+    if (valid.empty()) {
+        return game::EMPTY_COMPRESSED_MOVE;
+    }
+    uint64_t choice = util::getRand64() % total_weight;
+    for (const BookEntry* entry : valid) {
+        if (choice < entry->weight) {
+            return entry->move;
+        }
+        choice -= entry->weight;
+    }
+    return valid.back()->move;
+}
+
+OpeningBookBuilder::OpeningBookBuilder() : counts_() {
+    // intentionally blank
+}
+
+void OpeningBookBuilder::addGame(const std::vector<Move>& moves,
+                                 std::size_t max_plies) {
+    Board board(game::INIT_PIECE_MAP);
+    PieceColor color = game::START_COLOR;
+    std::vector<std::pair<uint64_t, CompressedMove>> played;
+    for (std::size_t ply = 0; ply < std::min(max_plies, moves.size());
+            ++ply) {
+        if (!game::isValidMove(board, color, moves[ply])) {
+            throw game::InvalidMoveEx(moves[ply]);
+        }
+        CompressedMove move = game::compressMove(moves[ply]);
+        played.emplace_back(player::computer::getBookKey(board, color), move);
+        game::makeMove(&board, move);
+        color = board::oppositeColor(color);
+    }
+    for (const auto& pair : played) {
+        ++counts_[pair];
+    }
+}
+
+std::size_t OpeningBookBuilder::size() const {
+    return counts_.size();
+}
+
+void OpeningBookBuilder::write(const std::string& path) const {
+    // counts_ is already sorted by (key, move)
+    std::vector<BookEntry> entries;
+    entries.reserve(counts_.size());
+    auto group_start = counts_.begin();
+    while (group_start != counts_.end()) {
+        uint64_t key = group_start->first.first;
+        auto group_end = group_start;
+        std::size_t max_count = 0;
+        while (group_end != counts_.end() && group_end->first.first == key) {
+            max_count = std::max(max_count, group_end->second);
+            ++group_end;
+        }
+        // scale weights down (keeping their ratios) iff they would overflow
+        for (auto it = group_start; it != group_end; ++it) {
+            std::size_t weight = it->second;
+            if (max_count > UINT16_MAX) {
+                weight = std::max<std::size_t>(1,
+                                               weight * UINT16_MAX / max_count);
+            }
+            entries.push_back(BookEntry{ key, it->first.second,
+                                         static_cast<uint16_t>(weight), 0 });
+        }
+        group_start = group_end;
+    }
+
+    BookHeader header;
+    std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.num_entries = entries.size();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()),
+               entries.size() * sizeof(BookEntry));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("cannot write book: " + path);
+    }
+}
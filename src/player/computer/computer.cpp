@@ -2,64 +2,197 @@
 
 #include "player/computer/computer.h"
 
+#include <algorithm>
 #include <string>
 
+#include "board/zobhash.h"
 #include "player/computer/search.h"
 #include "util/assert.h"
 
 using board::Board;
 using board::PieceColor;
+using game::CompressedMove;
 using game::Move;
 using player::computer::BoardScore;
-using player::computer::IScoreCache;
 using player::Computer;
 
-typedef util::FixedSizeMap<std::size_t, BoardScore> BaseMap;
+using player::computer::ScoreBound;
+using player::computer::TTEntry;
 
-static constexpr std::size_t CACHE_SIZE = 1000000;
-static constexpr std::size_t SEARCH_DEPTH = 6;
+static constexpr std::size_t BYTES_PER_MIB = 1 << 20;
 
-std::size_t hashWithDepth(const Board& board, std::size_t depth) {
-    ASSERT(depth >= 0,
-            "depth must be at least 0; depth: " + std::to_string(depth));
-    // TODO(theimer): something more clever
-    return std::hash<Board>{}(board) + depth;
+// bound_generation layout
+static constexpr uint8_t NUM_BOUND_BITS = 2;
+static constexpr uint8_t BOUND_MASK = (1 << NUM_BOUND_BITS) - 1;
+static constexpr uint8_t GENERATION_MASK = UINT8_MAX >> NUM_BOUND_BITS;
+
+// hashfull is estimated from this many entries (i.e. the first ones)
+static constexpr std::size_t HASHFULL_NUM_SAMPLES = 1000;
+
+// Entries lose this much replacement priority (measured in draft)
+//     per search since they were stored.
+static constexpr int64_t AGE_PRIORITY_WEIGHT = 8;
+
+static std::size_t hashWithColor(const Board& board, PieceColor color) {
+    std::size_t hash = board::applyZobSideToMove(std::hash<Board>{}(board),
+                                                 color);
+    // the map reserves 0 to mark empty entries
+    return (hash == 0) ? 1 : hash;
+}
+
+/*
+Returns the most buckets, as a power of two, that fit in `hash_size_mib`.
+*/
+static std::size_t getNumBuckets(std::size_t hash_size_mib) {
+    std::size_t max_num_buckets =
+            hash_size_mib * BYTES_PER_MIB
+            / util::BucketedMap<uint64_t>::CACHE_LINE_SIZE;
+    std::size_t num_buckets = 1;
+    while (num_buckets <= max_num_buckets / 2) {
+        num_buckets *= 2;
+    }
+    return num_buckets;
 }
 
-Computer::ScoreCacheImpl::ScoreCacheImpl(std::size_t size) :
-                                         BaseMap(size) {
+Computer::TranspositionTableImpl::TranspositionTableImpl(
+        std::size_t num_buckets) :
+        BucketedMap(num_buckets),
+        generation_(0) {
     // intentionally blank
 }
 
-BoardScore* Computer::ScoreCacheImpl::end() const {
-    return BaseMap::end();
+bool Computer::TranspositionTableImpl::probe(const Board& board,
+                                             PieceColor color,
+                                             TTEntry* entry) const {
+    PackedTTEntry packed;
+    if (!BucketedMap::find(hashWithColor(board, color), &packed)) {
+        return false;
+    }
+    entry->score = packed.score;
+    entry->best_move = packed.best_move;
+    entry->draft = packed.draft;
+    entry->bound = static_cast<ScoreBound>(packed.bound_generation
+                                           & BOUND_MASK);
+    entry->generation = packed.bound_generation >> NUM_BOUND_BITS;
+    return true;
+}
+
+bool Computer::TranspositionTableImpl::store(const Board& board,
+                                             PieceColor color,
+                                             BoardScore score,
+                                             CompressedMove best_move,
+                                             std::size_t draft,
+                                             ScoreBound bound) {
+    ASSERT(draft <= UINT8_MAX, "draft too large: " + std::to_string(draft));
+    std::size_t hash = hashWithColor(board, color);
+
+    // Keep an entry from the current search if it was searched deeper
+    //     than this one.
+    PackedTTEntry existing;
+    if (BucketedMap::find(hash, &existing)
+            && (existing.bound_generation >> NUM_BOUND_BITS) == generation_
+            && existing.draft > draft) {
+        return false;
+    }
+
+    PackedTTEntry packed;
+    ASSERT(score >= -player::computer::MAX_SCORE
+           && score <= player::computer::MAX_SCORE,
+           "score out of bounds: " + std::to_string(score));
+    packed.score = static_cast<int32_t>(score);
+    packed.best_move = best_move;
+    packed.draft = static_cast<uint8_t>(draft);
+    packed.bound_generation = static_cast<uint8_t>(
+            (generation_ << NUM_BOUND_BITS) | static_cast<uint8_t>(bound));
+
+    // Within a full bucket, replace shallow entries from old searches first.
+    uint8_t generation = generation_;
+    return BucketedMap::set(hash, packed,
+                            [generation](const PackedTTEntry& entry) {
+        int64_t age = (generation - (entry.bound_generation >> NUM_BOUND_BITS))
+                      & GENERATION_MASK;
+        return static_cast<int64_t>(entry.draft) - AGE_PRIORITY_WEIGHT * age;
+    });
 }
 
-BoardScore* Computer::ScoreCacheImpl::find(const Board& board,
-                                           std::size_t depth) const {
-    ASSERT(depth >= 0,
-            "depth must be at least 0; depth: " + std::to_string(depth));
-    std::size_t hash_with_depth = hashWithDepth(board, depth);
-    return BaseMap::find(hash_with_depth);
+void Computer::TranspositionTableImpl::newSearch() {
+    generation_ = (generation_ + 1) & GENERATION_MASK;
 }
 
-void Computer::ScoreCacheImpl::set(const Board& board, std::size_t depth,
-                                   BoardScore value) {
-    ASSERT(depth >= 0,
-            "depth must be at least 0; depth: " + std::to_string(depth));
-    std::size_t hash_with_depth = hashWithDepth(board, depth);
-    BaseMap::set(hash_with_depth, value);
+std::size_t Computer::TranspositionTableImpl::getHashfull() const {
+    std::size_t num_samples = std::min(HASHFULL_NUM_SAMPLES, capacity());
+    std::size_t num_current = 0;
+    PackedTTEntry entry;
+    for (std::size_t i = 0; i < num_samples; ++i) {
+        if (BucketedMap::getEntry(i, &entry)
+                && (entry.bound_generation >> NUM_BOUND_BITS) == generation_) {
+            ++num_current;
+        }
+    }
+    return num_current * 1000 / num_samples;
 }
 
-Computer::Computer(std::string name) :
+Computer::Computer(std::string name, std::size_t num_threads,
+                   std::size_t hash_size_mib, bool randomize_ties,
+                   const player::computer::SearchLimits& limits,
+                   const player::computer::PruningParams& pruning,
+                   const player::computer::OpeningBook* book,
+                   const player::computer::Tablebases* tablebases) :
         Player(name),
-        score_cache_(CACHE_SIZE) {
+        transposition_table_(getNumBuckets(hash_size_mib)),
+        table_color_(PieceColor::NUM_PIECE_COLORS),
+        num_threads_(num_threads),
+        randomize_ties_(randomize_ties),
+        limits_(limits),
+        pruning_(pruning),
+        book_(book),
+        tablebases_(tablebases),
+        stop_token_(),
+        last_search_stats_(),
+        last_principal_variation_() {
+    ASSERT(num_threads > 0, "must have at least one thread");
+    ASSERT(hash_size_mib > 0, "hash size must be at least 1 MiB");
     // intentionally blank
 }
 
-Move Computer::getMove(const Board& board, PieceColor color) {
-    return player::computer::alphaBetaSearch(
-                                  board, color, SEARCH_DEPTH,
-                                  &player::computer::basicBoardHeuristic,
-                                  &score_cache_);
+Move Computer::getMove(const Board& board, PieceColor color,
+                       const std::vector<std::size_t>& history) {
+    if (book_ != nullptr) {
+        CompressedMove book_move = book_->pickMove(board, color);
+        if (book_move != game::EMPTY_COMPRESSED_MOVE) {
+            last_search_stats_ = player::computer::SearchStats();
+            last_principal_variation_.assign(1, book_move);
+            stop_token_.reset();
+            return game::decompressMove(book_move);
+        }
+    }
+    // entries searched for the other color score from its perspective
+    if (table_color_ != color) {
+        if (table_color_ != PieceColor::NUM_PIECE_COLORS) {
+            transposition_table_.clear();
+        }
+        table_color_ = color;
+    }
+    CompressedMove move = player::computer::negamaxSearch(
+            board, color, &history, limits_, pruning_,
+            player::computer::BasicBoardEvaluator(), &transposition_table_,
+            tablebases_, num_threads_, randomize_ties_, &stop_token_,
+            &last_search_stats_, &last_principal_variation_);
+    // cleared only now, so a stop requested before the search began
+    //     isn't lost
+    stop_token_.reset();
+    return game::decompressMove(move);
+}
+
+void Computer::stop() {
+    stop_token_.requestStop();
+}
+
+const player::computer::SearchStats& Computer::getLastSearchStats() const {
+    return last_search_stats_;
+}
+
+const std::vector<CompressedMove>&
+Computer::getLastPrincipalVariation() const {
+    return last_principal_variation_;
 }
@@ -0,0 +1,264 @@
+// Copyright 2021 Alex Theimer
+
+#include "player/computer/match.h"
+
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "game/game.h"
+#include "player/computer/computer.h"
+
+using board::Board;
+using board::PieceColor;
+using game::Move;
+using player::Computer;
+using player::computer::EngineConfig;
+using player::computer::GameOutcome;
+using player::computer::MatchGameResult;
+using player::computer::MatchOptions;
+using player::computer::MatchResults;
+using player::computer::Sprt;
+using player::computer::SprtDecision;
+
+// outcomes counted in addition to those played (see Sprt)
+static constexpr double SPRT_PSEUDO_COUNT = 0.5;
+
+/*
+Returns the expected score of a player `elo` stronger than its opponent.
+*/
+static double getExpectedScore(double elo) {
+    return 1 / (1 + std::pow(10, -elo / 400));
+}
+
+std::size_t MatchResults::getNumGames() const {
+    return num_wins + num_draws + num_losses;
+}
+
+double MatchResults::getScore() const {
+    std::size_t num_games = getNumGames();
+    if (num_games == 0) {
+        return 0.5;
+    }
+    return (num_wins + num_draws / 2.0) / num_games;
+}
+
+double MatchResults::getEloDifference() const {
+    double score = getScore();
+    if (score == 0 || score == 1) {
+        return (score == 1) ? std::numeric_limits<double>::infinity()
+                            : -std::numeric_limits<double>::infinity();
+    }
+    return -400 * std::log10(1 / score - 1);
+}
+
+Sprt::Sprt(double elo0, double elo1, double alpha, double beta) :
+        score0_(getExpectedScore(elo0)),
+        score1_(getExpectedScore(elo1)),
+        lower_bound_(std::log(beta / (1 - alpha))),
+        upper_bound_(std::log((1 - beta) / alpha)) {
+    if (!(elo0 < elo1)) {
+        throw std::invalid_argument("elo0 must be < elo1");
+    }
+    if (!(alpha > 0 && alpha < 0.5) || !(beta > 0 && beta < 0.5)) {
+        throw std::invalid_argument("alpha and beta must be in (0, 0.5)");
+    }
+}
+
+double Sprt::getLowerBound() const {
+    return lower_bound_;
+}
+
+double Sprt::getUpperBound() const {
+    return upper_bound_;
+}
+
+double Sprt::getLogLikelihoodRatio(const MatchResults& results) const {
+    double wins = results.num_wins + SPRT_PSEUDO_COUNT;
+    double draws = results.num_draws + SPRT_PSEUDO_COUNT;
+    double losses = results.num_losses + SPRT_PSEUDO_COUNT;
+    double num_games = wins + draws + losses;
+    double score = (wins + draws / 2) / num_games;
+    double variance = (wins * (1 - score) * (1 - score)
+                       + draws * (0.5 - score) * (0.5 - score)
+                       + losses * score * score) / num_games;
+    // log(N(score; score1_, var) / N(score; score0_, var)), over every game
+    return num_games * (score1_ - score0_) * (2 * score - score0_ - score1_)
+           / (2 * variance);
+}
+
+SprtDecision Sprt::getDecision(const MatchResults& results) const {
+    double llr = getLogLikelihoodRatio(results);
+    if (llr <= lower_bound_) {
+        return SprtDecision::ACCEPT_H0;
+    }
+    if (llr >= upper_bound_) {
+        return SprtDecision::ACCEPT_H1;
+    }
+    return SprtDecision::CONTINUE;
+}
+
+/*
+Plays the position after an opening, and returns the color to move.
+@throws game::InvalidMoveEx if a move is invalid.
+@throws std::invalid_argument if the opening ends the game.
+*/
+static PieceColor playOpening(const std::vector<Move>& opening,
+                              Board* board) {
+    PieceColor color = game::START_COLOR;
+    for (const Move& move : opening) {
+        if (!game::isValidMove(*board, color, move)) {
+            throw game::InvalidMoveEx(move);
+        }
+        game::makeMove(board, game::compressMove(move));
+        color = board::oppositeColor(color);
+        // (the game doesn't need players to tell whether it's over)
+        if (game::Game(board, nullptr, nullptr, color).isEnded()) {
+            throw std::invalid_argument("opening ends the game");
+        }
+    }
+    return color;
+}
+
+/*
+Plays one game of a match.
+@param result: opening_index and first_color must be set; the rest is
+               set iff the game completes.
+@return: false iff the game was abandoned (i.e. `stop` was set).
+*/
+static bool playGame(const EngineConfig& first, const EngineConfig& second,
+                     const std::vector<Move>& opening, std::size_t max_plies,
+                     const std::atomic<bool>& stop,
+                     MatchGameResult* result) {
+    Board board(game::INIT_PIECE_MAP);
+    PieceColor color = playOpening(opening, &board);
+
+    // fresh players, so no game inherits another's transposition table
+    Computer first_player(first.name, 1, first.hash_size_mib, true,
+                          first.limits, first.pruning, nullptr, nullptr);
+    Computer second_player(second.name, 1, second.hash_size_mib, true,
+                           second.limits, second.pruning, nullptr, nullptr);
+    bool first_is_white = result->first_color == PieceColor::WHITE;
+    game::Game game(&board,
+                    first_is_white ? &first_player : &second_player,
+                    first_is_white ? &second_player : &first_player,
+                    color);
+
+    std::size_t num_plies = 0;
+    while (!game.isEnded() && num_plies < max_plies) {
+        if (stop.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        game.runPly();
+        ++num_plies;
+    }
+
+    result->num_plies = num_plies;
+    if (!game.isEnded() || game.isDrawn()) {
+        result->outcome = GameOutcome::DRAW;
+    } else if (&game.getWinner() == &first_player) {
+        result->outcome = GameOutcome::WIN;
+    } else {
+        result->outcome = GameOutcome::LOSS;
+    }
+    return true;
+}
+
+MatchResults player::computer::runMatch(
+        const EngineConfig& first, const EngineConfig& second,
+        const std::vector<std::vector<Move>>& openings,
+        const MatchOptions& options, const MatchCallback& callback) {
+    if (options.num_threads == 0) {
+        throw std::invalid_argument("must have at least one thread");
+    }
+    // fail before any game starts
+    for (const std::vector<Move>& opening : openings) {
+        Board board(game::INIT_PIECE_MAP);
+        playOpening(opening, &board);
+    }
+    const std::vector<std::vector<Move>> no_openings(1);
+    const std::vector<std::vector<Move>>& games_openings =
+            openings.empty() ? no_openings : openings;
+
+    std::atomic<std::size_t> next_game_index(0);
+    std::atomic<bool> stop(false);
+    // guards the rest
+    std::mutex mutex;
+    MatchResults results{ 0, 0, 0 };
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            std::size_t game_index = next_game_index.fetch_add(1);
+            if (game_index >= options.num_games) {
+                return;
+            }
+            MatchGameResult game_result;
+            game_result.game_index = game_index;
+            game_result.opening_index = (game_index / 2)
+                                        % games_openings.size();
+            // the engines swap colors between the games of each pair
+            game_result.first_color = (game_index % 2 == 0)
+                    ? game::START_COLOR
+                    : board::oppositeColor(game::START_COLOR);
+            try {
+                if (!playGame(first, second,
+                              games_openings[game_result.opening_index],
+                              options.max_plies, stop, &game_result)) {
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                // decided while this game was in progress
+                if (stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                switch (game_result.outcome) {
+                case GameOutcome::WIN:
+                    ++results.num_wins;
+                    break;
+                case GameOutcome::DRAW:
+                    ++results.num_draws;
+                    break;
+                case GameOutcome::LOSS:
+                    ++results.num_losses;
+                    break;
+                }
+                if (callback) {
+                    callback(game_result, results);
+                }
+                if (options.sprt != nullptr
+                        && options.sprt->getDecision(results)
+                           != SprtDecision::CONTINUE) {
+                    stop.store(true, std::memory_order_relaxed);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < options.num_threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return results;
+}
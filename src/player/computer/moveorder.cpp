@@ -0,0 +1,103 @@
+// Copyright 2021 Alex Theimer
+
+#include "player/computer/moveorder.h"
+
+#include <string>
+
+#include "util/assert.h"
+
+using board::Board;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+using game::CompressedMove;
+
+using player::computer::MoveOrdering;
+
+// Once any history score passes this, every score is halved. This keeps
+//     scores in range, and lets newer cutoffs outweigh old ones.
+static constexpr int32_t MAX_HISTORY_SCORE = 1 << 24;
+
+/*
+Rough value of each PieceType, indexed by PieceType.
+Capturing the KING ends the game, so it outweighs everything else.
+*/
+static constexpr int32_t PIECE_VALUES[] = {
+    1000,  // KING
+    9,     // QUEEN
+    1,     // PAWN
+    5,     // ROOK
+    3,     // KNIGHT
+    3      // BISHOP
+};
+static_assert(sizeof(PIECE_VALUES) / sizeof(PIECE_VALUES[0])
+              == static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES),
+              "missing piece values");
+
+// victims outrank attackers, so attacker values must stay below this
+static constexpr int32_t VICTIM_WEIGHT = 2048;
+
+static int32_t getPieceValue(PieceType type) {
+    return PIECE_VALUES[static_cast<std::size_t>(type)];
+}
+
+MoveOrdering::MoveOrdering() :
+        killers_(), history_() {
+    // intentionally blank
+}
+
+int32_t MoveOrdering::getCaptureScore(const Board& board,
+                                      CompressedMove move) {
+    ASSERT(game::isCaptureMove(move), "must be a capture");
+    Square from = Square::indexToSquare(game::getMoveFromIndex(move));
+    Square to = Square::indexToSquare(game::getMoveToIndex(move));
+    return getPieceValue(board.getPieceType(to)) * VICTIM_WEIGHT
+           - getPieceValue(board.getPieceType(from));
+}
+
+CompressedMove MoveOrdering::getKiller(std::size_t ply,
+                                       std::size_t slot) const {
+    ASSERT(slot < NUM_KILLERS, "invalid slot: " + std::to_string(slot));
+    if (ply >= MAX_PLY) {
+        return game::EMPTY_COMPRESSED_MOVE;
+    }
+    return killers_[ply][slot];
+}
+
+int32_t MoveOrdering::getHistoryScore(PieceColor color,
+                                      CompressedMove move) const {
+    return history_[static_cast<std::size_t>(color)]
+                   [game::getMoveFromIndex(move)]
+                   [game::getMoveToIndex(move)];
+}
+
+void MoveOrdering::updateCutoff(PieceColor color, CompressedMove move,
+                                std::size_t ply,
+                                std::size_t depth_remaining) {
+    if (game::isCaptureMove(move)) {
+        return;
+    }
+
+    if (ply < MAX_PLY && !game::isSameMove(killers_[ply][0], move)) {
+        for (std::size_t slot = NUM_KILLERS - 1; slot > 0; --slot) {
+            killers_[ply][slot] = killers_[ply][slot - 1];
+        }
+        killers_[ply][0] = move;
+    }
+
+    // deep cutoffs save far more work than shallow ones
+    int32_t& score = history_[static_cast<std::size_t>(color)]
+                             [game::getMoveFromIndex(move)]
+                             [game::getMoveToIndex(move)];
+    score += static_cast<int32_t>(depth_remaining * depth_remaining);
+    if (score > MAX_HISTORY_SCORE) {
+        for (auto& color_history : history_) {
+            for (auto& from_history : color_history) {
+                for (int32_t& to_score : from_history) {
+                    to_score /= 2;
+                }
+            }
+        }
+    }
+}
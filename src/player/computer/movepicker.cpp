@@ -0,0 +1,150 @@
+// Copyright 2021 Alex Theimer
+
+#include "player/computer/movepicker.h"
+
+#include <limits>
+
+#include "util/assert.h"
+
+using board::Board;
+using board::PieceColor;
+using board::Square;
+
+using game::CompressedMove;
+
+using player::computer::MovePicker;
+
+/*
+Returns the generated (i.e. correctly-flagged) version of `move` if it's
+a valid move for `color`; otherwise, returns EMPTY_COMPRESSED_MOVE.
+
+Note: a best move might come from a different position (i.e. a hash
+      collision), so it always needs to be checked.
+*/
+static CompressedMove validateMove(const Board& board, PieceColor color,
+                                   CompressedMove move) {
+    if (move == game::EMPTY_COMPRESSED_MOVE) {
+        return game::EMPTY_COMPRESSED_MOVE;
+    }
+    Square from = Square::indexToSquare(game::getMoveFromIndex(move));
+    if (!board.squareIsOccupiedColor(from, color)) {
+        return game::EMPTY_COMPRESSED_MOVE;
+    }
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> piece_moves;
+    std::size_t num_moves =
+            game::getPieceMoves(board, color, from, piece_moves.start());
+    for (std::size_t i = 0; i < num_moves; ++i) {
+        if (game::isSameMove(move, piece_moves.get(i))) {
+            return piece_moves.get(i);
+        }
+    }
+    return game::EMPTY_COMPRESSED_MOVE;
+}
+
+MovePicker::MovePicker(const Board& board, PieceColor color,
+                       CompressedMove best_move,
+                       const MoveOrdering& ordering, std::size_t ply) :
+        board_(board), color_(color),
+        best_move_(validateMove(board, color, best_move)),
+        ordering_(&ordering), ply_(ply),
+        stage_(Stage::BEST_MOVE), num_moves_(0), next_index_(0) {
+    // intentionally blank
+}
+
+MovePicker::MovePicker(const Board& board, PieceColor color) :
+        board_(board), color_(color),
+        best_move_(game::EMPTY_COMPRESSED_MOVE),
+        ordering_(nullptr), ply_(0),
+        stage_(Stage::BEST_MOVE), num_moves_(0), next_index_(0) {
+    // intentionally blank
+}
+
+void MovePicker::scoreQuiets() {
+    // Killers only match moves generated here, so they're always valid.
+    // They outrank every history score; earlier slots are more recent.
+    CompressedMove killers[MoveOrdering::NUM_KILLERS];
+    for (std::size_t slot = 0; slot < MoveOrdering::NUM_KILLERS; ++slot) {
+        killers[slot] = ordering_->getKiller(ply_, slot);
+    }
+    for (std::size_t i = 0; i < num_moves_; ++i) {
+        CompressedMove move = moves_.get(i);
+        int32_t score = ordering_->getHistoryScore(color_, move);
+        for (std::size_t slot = 0; slot < MoveOrdering::NUM_KILLERS;
+                ++slot) {
+            if (game::isSameMove(move, killers[slot])) {
+                score = std::numeric_limits<int32_t>::max()
+                        - static_cast<int32_t>(slot);
+                break;
+            }
+        }
+        scores_.set(i, score);
+    }
+}
+
+void MovePicker::sortStage() {
+    // Insertion sort: most scores are equal (i.e. zero history), which
+    //     makes this close to linear.
+    for (std::size_t i = 1; i < num_moves_; ++i) {
+        CompressedMove move = moves_.get(i);
+        int32_t score = scores_.get(i);
+        std::size_t j = i;
+        for (; j > 0 && scores_.get(j - 1) < score; --j) {
+            moves_.set(j, moves_.get(j - 1));
+            scores_.set(j, scores_.get(j - 1));
+        }
+        moves_.set(j, move);
+        scores_.set(j, score);
+    }
+}
+
+void MovePicker::generateNextStage() {
+    next_index_ = 0;
+    switch (stage_) {
+    case Stage::GENERATE_CAPTURES:
+        num_moves_ = game::getAllCaptures(board_, color_, moves_.start());
+        for (std::size_t i = 0; i < num_moves_; ++i) {
+            scores_.set(i, MoveOrdering::getCaptureScore(board_,
+                                                         moves_.get(i)));
+        }
+        sortStage();
+        stage_ = Stage::CAPTURES;
+        break;
+    case Stage::CAPTURES:
+        if (ordering_ == nullptr) {
+            // captures only
+            num_moves_ = 0;
+            stage_ = Stage::DONE;
+            break;
+        }
+        num_moves_ = game::getAllQuiets(board_, color_, moves_.start());
+        scoreQuiets();
+        sortStage();
+        stage_ = Stage::QUIETS;
+        break;
+    default:
+        num_moves_ = 0;
+        stage_ = Stage::DONE;
+        break;
+    }
+}
+
+CompressedMove MovePicker::next() {
+    if (stage_ == Stage::BEST_MOVE) {
+        stage_ = Stage::GENERATE_CAPTURES;
+        if (best_move_ != game::EMPTY_COMPRESSED_MOVE) {
+            return best_move_;
+        }
+    }
+    while (stage_ != Stage::DONE) {
+        while (next_index_ < num_moves_) {
+            CompressedMove move = moves_.get(next_index_);
+            ++next_index_;
+            // the best move was already returned
+            if (!game::isSameMove(move, best_move_)) {
+                return move;
+            }
+        }
+        generateNextStage();
+    }
+    return game::EMPTY_COMPRESSED_MOVE;
+}
@@ -0,0 +1,34 @@
+// Copyright 2021 Alex Theimer
+
+#include "player/computer/pruning.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "util/assert.h"
+
+using player::computer::PruningParams;
+using player::computer::ReductionTable;
+
+ReductionTable::ReductionTable(const PruningParams& params) {
+    ASSERT(params.lmr_divisor > 0,
+           "invalid lmr_divisor: " + std::to_string(params.lmr_divisor));
+    bool enabled = params.lmr_min_depth > 0;
+    for (std::size_t depth = 0; depth <= MAX_DEPTH; ++depth) {
+        for (std::size_t index = 0; index < game::MAX_NUM_MOVES_PLY;
+                ++index) {
+            std::size_t reduction = 0;
+            if (enabled && depth >= params.lmr_min_depth
+                    && index >= params.lmr_min_move_index && index > 0) {
+                double raw = params.lmr_base
+                        + std::log(depth) * std::log(index)
+                          / params.lmr_divisor;
+                reduction = (raw > 0) ? static_cast<std::size_t>(raw) : 0;
+                // always leave one ply
+                reduction = std::min(reduction, depth - 1);
+            }
+            reductions_[depth][index] = static_cast<uint8_t>(reduction);
+        }
+    }
+}
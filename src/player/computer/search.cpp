@@ -2,12 +2,19 @@
 
 #include "player/computer/search.h"
 
-#include <limits>
-#include <random>
-#include <cstdlib>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <thread>
 #include <vector>
 
+#include "player/computer/moveorder.h"
+#include "player/computer/movepicker.h"
+#include "player/computer/pruning.h"
+#include "player/computer/tablebase.h"
 #include "util/buffer.h"
 #include "util/macro.h"
 
@@ -16,11 +23,26 @@ using board::PieceColor;
 using board::Piece;
 using board::Square;
 
-using player::computer::IScoreCache;
+using player::computer::ITranspositionTable;
+using player::computer::ScoreBound;
+using player::computer::TTEntry;
+using player::computer::MoveOrdering;
+using player::computer::MovePicker;
+using player::computer::PruningParams;
+using player::computer::ReductionTable;
+using player::computer::Tablebases;
 using player::computer::BoardScore;
+using player::computer::MAX_SCORE;
 using player::computer::BoardHeuristicFunc;
+using player::computer::BasicBoardEvaluator;
+using player::computer::HeuristicFuncEvaluator;
+using player::computer::SearchLimits;
+using player::computer::StopToken;
+using player::computer::SearchCounters;
+using player::computer::SearchStats;
+using player::computer::IterationStats;
 
-using game::Move;
+using game::CompressedMove;
 
 /*
 ################################################################################
@@ -96,307 +118,1015 @@ using game::Move;
         maximizing player would never allow the game state to reach
         that subtree.
 
-    (3) This Implementation
+    (3) Negamax
+
+        Since max(a, b) == -min(-a, -b), a minimizing node is just a
+        maximizing node that sees every score negated. Negamax scores
+        each node from the perspective of the player to move there, and
+        a parent negates the scores of its children. Alpha and beta
+        swap (and negate) on the way down:
+
+            score(node) = max over children of -score(child)
+            child window = (-beta, -alpha)
+
+        Scores must therefore be symmetric around zero; they all lie
+        within [-MAX_SCORE, MAX_SCORE].
+
+    (4) This Implementation
+
+        negamax is a template, specialized at compile time on:
+
+            - the node type. ROOT nodes collect every best move;
+              PV nodes (the first child of a PV node) are searched
+              with an open window and never cut off from the
+              transposition table; every other node is NON_PV.
+            - the evaluator type. Leaves call the evaluator directly,
+              so e.g. BasicBoardEvaluator is inlined into the search.
+
+        Only the first child of a PV node is searched with the full
+        window (principal variation search). With good move ordering,
+        it's usually the best move, so every later child is searched
+        with a "null" window (alpha, alpha + 1) that only proves
+        whether the child is worse; that's much cheaper than finding
+        its exact score. If a child isn't worse after all, it's searched
+        again with the full window.
+
+        The search is also selective; see player/computer/pruning.h.
+        A null move "passes" the turn without changing the Board; the
+        transposition table tells the two apart by the color to move.
+
+        Note that the heuristic is always applied from the root
+        player's perspective, then negated for the opponent's nodes.
+        Heuristics (i.e. basicBoardHeuristic) needn't be zero-sum.
+
+        negamaxSearch deepens iteratively: it searches to depth 1, 2,
+        3, ... until the SearchLimits run out. Each iteration is cheap
+        next to the one after it, and it leaves behind best moves (in
+        the transposition table) and root move scores that order the
+        next iteration's search.
+
+        An iteration's score is usually close to the previous one's, so
+        each iteration (after the first) starts with a narrow
+        "aspiration" window around it. A narrower window cuts off
+        more. If the score falls outside of the window, the window is
+        widened and the iteration is searched again.
+
+    (5) The Transposition Table
+
+        Different move orders often reach the same Board, so each node
+        stores its result in a transposition table. A node's score is
+        only exact when it falls strictly between alpha and beta; a
+        node that cut off (or never raised its bound) only proves that
+        its true score is on one side of the returned score. Entries
+        therefore record which kind of bound they hold, and a later
+        visit uses them to return immediately. Entries also remember
+        the best move found, which is searched first on the next visit.
+
+    (6) Quiescence Search
+
+        A fixed-depth search evaluates its leaves wherever they fall,
+        even halfway through an exchange of pieces; the "horizon"
+        hides the recapture. So instead of evaluating a leaf directly,
+        the search continues there with captures only, until the Board
+        is quiet.
+
+        The player to move needn't capture, though, so the static
+        evaluation is a lower bound on a quiescence node's score (i.e.
+        "standing pat"). If it already reaches beta, the node cuts off
+        without searching any capture. Every capture removes a piece,
+        so the capture sequences are always finite.
+
+    (7) Endgame Tablebases
+
+        Once few enough pieces remain, the outcome of a Board under
+        perfect play can simply be looked up (see tablebase.h). A node
+        whose Board is in a table isn't searched at all; it scores a
+        win (or loss) by how soon the king capture happens, so that the
+        search prefers quick wins and drawn-out losses.
+
+    (8) Repetitions
+
+        Players can move pieces back and forth forever; a line of the
+        search that returns to an earlier position has gained nothing,
+        and would only search the same subtree again. A node whose
+        position occurred before (earlier in its line, or earlier in
+        the game) is scored as a draw instead of searched: either
+        player could force the cycle again.
+
+        Only positions since the last capture can repeat, since a
+        capture removes a piece for good, and only those with the same
+        player to move. So each node keeps its position's key on a
+        stack, and the scan for an equal key goes back two plies at a
+        time, and stops at the last capture (or null move).
+
+    (9) King Captures
+
+        The game ends once a king is captured, so a node whose player
+        to move has lost their king isn't searched (or evaluated): it's
+        lost, and scores -(WIN_SCORE - ply). Wins found nearer the root
+        therefore score higher, and the search plays the quickest win
+        it finds (and the slowest loss).
+
+        A node at `ply` can't score better than a king capture on its
+        very next move, nor worse than having already lost its king.
+        Once alpha and beta are narrowed to those bounds, a node cut
+        off when a shorter win is already known elsewhere in the tree
+        ("mate-distance pruning").
+
+        A win's score depends on the distance from the root, but a
+        transposition table entry may be found again at another ply
+        (or in a later search). Entries therefore hold win scores
+        relative to their own node (i.e. less the plies from that node
+        on), which are converted back on every probe.
 
-        alphaBetaSearch is the "root" call of the search tree. It will
-        call alphaBetaSearchMin, which will call alphaBetaSearchMax,
-        which calls alphaBetaSearchMin, etc. Each one of these calls
-        acts as one of the nodes of the search tree.
+################################################################################
+*/
 
-        alphaBetaSearchMax and alphaBetaSearchMin are almost identical
-        except for a few parameters. Therefore, these functions call
-        the helper function alphaBetaSearchBase with their
-        min/max-specific parameters.
+namespace {
 
-################################################################################
+enum class NodeType {
+    ROOT,
+    PV,
+    NON_PV
+};
+
+static_assert(player::computer::MAX_SEARCH_DEPTH < MoveOrdering::MAX_PLY,
+              "every ply of the search needs killer slots");
+static_assert(player::computer::MAX_SEARCH_DEPTH <= ReductionTable::MAX_DEPTH,
+              "every depth of the search needs reductions");
+
+typedef std::chrono::steady_clock Clock;
+
+// Once per this many nodes, a thread adds them to the shared count of
+//     nodes, and the clock is read.
+constexpr std::size_t POLL_INTERVAL = 1024;
+
+// half the width of the first aspiration window of an iteration;
+//     doubles after every failure.
+constexpr BoardScore ASPIRATION_DELTA = 1;
+
+/*
+A move at the root, with its score from the latest iteration.
 */
+struct RootMove {
+    CompressedMove move;
+    BoardScore score;
+    // the principal variation that starts with `move`; only meaningful
+    //     if the move is tied for the best score
+    std::vector<CompressedMove> pv;
+};
 
-// signature of alphaBetaSearchMin and alphaBetaSearchMax
-typedef BoardScore (*AlphaBetaVariantFunc)(
-                           Board* board, PieceColor color,
-                           std::size_t depth_remaining,
-                           BoardScore alpha, BoardScore beta,
-                           BoardHeuristicFunc board_heuristic,
-                           IScoreCache* score_cache);
+/*
+State shared by every node of one thread's search.
+*/
+template <typename Evaluator>
+struct SearchContext {
+    const Evaluator& evaluator;
+    ITranspositionTable* transposition_table;
+    const Tablebases* tablebases;  // nullptr if none
+    // once set, the search unwinds without storing any more results;
+    //     returned scores are meaningless.
+    std::atomic<bool>* stop;
+    // the color of the player searching for a move
+    PieceColor root_color;
+    // searched in order at the root
+    std::vector<RootMove> root_moves;
+    // every move tied for the best score at the root
+    std::vector<CompressedMove> root_best_moves;
+
+    // killers and history of this thread
+    MoveOrdering move_ordering;
+
+    const PruningParams& pruning;
+    ReductionTable reductions;
+    // null_moves[ply] is true iff the move that led to `ply` was a null move
+    bool null_moves[player::computer::MAX_SEARCH_DEPTH + 1];
+
+    // keys of the game's positions before the root, back to the last
+    //     capture (see game::Player::getMove); nullptr if none
+    const std::vector<std::size_t>* history;
+    // line_keys[ply] is the key of the position being searched at `ply`
+    std::size_t line_keys[player::computer::MAX_SEARCH_DEPTH + 1];
+    // reversible_plies[ply] counts the positions before `ply` (in the
+    //     line, then in the history) since the last capture or null move
+    std::size_t reversible_plies[player::computer::MAX_SEARCH_DEPTH + 1];
+
+    // Principal variations: pv[ply] holds pv_lengths[ply] moves, the best
+    //     line found so far from the PV node being searched at `ply`.
+    CompressedMove pv[player::computer::MAX_SEARCH_DEPTH + 1]
+                     [player::computer::MAX_SEARCH_DEPTH];
+    std::size_t pv_lengths[player::computer::MAX_SEARCH_DEPTH + 1];
+
+    // count of nodes searched by this thread
+    SearchCounters counters;
+    // nodes searched by every thread, in batches of POLL_INTERVAL
+    std::atomic<std::size_t>* shared_num_nodes;
+
+    // if true, the hard limits below are enforced by setting `stop`
+    bool enforce_limits;
+    std::size_t max_nodes;  // 0 if unlimited
+    bool has_hard_deadline;
+    Clock::time_point hard_deadline;
+    const StopToken* stop_token;  // nullptr if none
+
+    SearchContext(const Evaluator& evaluator,
+                  ITranspositionTable* transposition_table,
+                  const Tablebases* tablebases,
+                  std::atomic<bool>* stop,
+                  std::atomic<std::size_t>* shared_num_nodes,
+                  PieceColor root_color, const PruningParams& pruning,
+                  const std::vector<std::size_t>* history) :
+            evaluator(evaluator), transposition_table(transposition_table),
+            tablebases(tablebases), stop(stop), root_color(root_color),
+            pruning(pruning), reductions(pruning), null_moves(),
+            history(history), line_keys(), reversible_plies(), counters(),
+            shared_num_nodes(shared_num_nodes), enforce_limits(false),
+            max_nodes(0), has_hard_deadline(false), stop_token(nullptr) {
+        reversible_plies[0] = (history != nullptr) ? history->size() : 0;
+    }
+};
+
+/*
+Counts a node, then sets `stop` if a hard limit has been hit (or a stop
+was requested).
+*/
+template <typename Evaluator>
+inline void countNode(SearchContext<Evaluator>* context) {
+    ++context->counters.num_nodes;
+    bool poll = context->counters.num_nodes % POLL_INTERVAL == 0;
+    std::size_t shared_num_nodes = 0;
+    if (poll) {
+        shared_num_nodes = context->shared_num_nodes->fetch_add(
+                POLL_INTERVAL, std::memory_order_relaxed) + POLL_INTERVAL;
+    }
+    if (!context->enforce_limits) {
+        return;
+    }
+    if ((context->stop_token != nullptr
+                && context->stop_token->isStopRequested())
+            || (poll && context->max_nodes > 0
+                && shared_num_nodes >= context->max_nodes)
+            || (poll && context->has_hard_deadline
+                && Clock::now() >= context->hard_deadline)) {
+        context->stop->store(true, std::memory_order_relaxed);
+    }
+}
 
-// These are passed as argument to alphaBetaSearchBase.
-//    See definition for details.
-typedef BoardScore (*ScoreUpdateFunc)(BoardScore score,
-                                      BoardScore child_score);
-typedef bool (*ExitCondFunc)(BoardScore alpha, BoardScore beta,
-                             BoardScore score);
-typedef void (*BoundUpdateFunc)(BoardScore* alpha, BoardScore* beta,
-                                BoardScore score);
+/*
+Sets the root moves of a context to every move available to `color`.
+*/
+template <typename Evaluator>
+void initRootMoves(SearchContext<Evaluator>* context, const Board& board,
+                   PieceColor color) {
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves = game::getAllMoves(board, color,
+                                              move_buffer.start());
+    context->root_moves.clear();
+    for (std::size_t i = 0; i < num_moves; ++i) {
+        context->root_moves.push_back(RootMove{ move_buffer.get(i), 0,
+                                                {} });
+    }
+}
 
-// Forward-declare both of the variants because their definitions
-//     reference each other.
+/*
+Orders the root moves by descending score, for the next iteration.
+The sort is stable, so ties keep their previous order.
+*/
+template <typename Evaluator>
+void orderRootMoves(SearchContext<Evaluator>* context) {
+    std::stable_sort(context->root_moves.begin(), context->root_moves.end(),
+                     [](const RootMove& first, const RootMove& second) {
+        return first.score > second.score;
+    });
+}
 
 /*
-Maximizer variant of the search.
+Returns true iff `color` has a piece other than its king and pawns.
+*/
+inline bool hasPieces(const Board& board, PieceColor color) {
+    return (board.getColorBitboard(color)
+            & ~board.getPieceTypeBitboard(board::PieceType::KING)
+            & ~board.getPieceTypeBitboard(board::PieceType::PAWN)) != 0;
+}
 
-A "friendly" node in the search tree.
+/*
+Returns the score of capturing the opposing king `ply` plies from the
+root (see WIN_SCORE).
+*/
+inline BoardScore getWinScore(std::size_t ply) {
+    return player::computer::WIN_SCORE - static_cast<BoardScore>(ply);
+}
 
-@param board: the board to evaluate.
-@param color: the color of the maximizing player.
-@param depth_remaining: must be >= 0
+/*
+Returns true iff `color` has lost their king (i.e. the game is over).
 */
-BoardScore alphaBetaSearchMax(Board* board, PieceColor color,
-                           std::size_t depth_remaining,
-                           BoardScore alpha, BoardScore beta,
-                           BoardHeuristicFunc board_heuristic,
-                           IScoreCache* score_cache);
+inline bool hasLostKing(const Board& board, PieceColor color) {
+    return (board.getColorBitboard(color)
+            & board.getPieceTypeBitboard(board::PieceType::KING)) == 0;
+}
+
+/*
+Probes the transposition table of a context, and counts the probe.
+@param ply: distance from the root (see store).
+*/
+template <typename Evaluator>
+inline bool probe(SearchContext<Evaluator>* context, const Board& board,
+                  PieceColor color, std::size_t ply, TTEntry* entry) {
+    ++context->counters.num_tt_probes;
+    if (!context->transposition_table->probe(board, color, entry)) {
+        return false;
+    }
+    ++context->counters.num_tt_hits;
+    // the entry's win is relative to its node; make it relative to the root
+    if (entry->score >= player::computer::MIN_WIN_SCORE) {
+        entry->score -= static_cast<BoardScore>(ply);
+    } else if (entry->score <= -player::computer::MIN_WIN_SCORE) {
+        entry->score += static_cast<BoardScore>(ply);
+    }
+    return true;
+}
+
 /*
-Minimizer variant of the search.
+Stores to the transposition table of a context, and counts the store.
+A win (or loss) is stored relative to the node (i.e. its distance from
+the root is removed), so the entry stays valid at any ply.
+@param ply: distance from the root.
+*/
+template <typename Evaluator>
+inline void store(SearchContext<Evaluator>* context, const Board& board,
+                  PieceColor color, std::size_t ply, BoardScore score,
+                  CompressedMove best_move, std::size_t draft,
+                  ScoreBound bound) {
+    ++context->counters.num_tt_stores;
+    if (score >= player::computer::MIN_WIN_SCORE) {
+        score += static_cast<BoardScore>(ply);
+    } else if (score <= -player::computer::MIN_WIN_SCORE) {
+        score -= static_cast<BoardScore>(ply);
+    }
+    if (context->transposition_table->store(board, color, score, best_move,
+                                            draft, bound)) {
+        ++context->counters.num_tt_overwrites;
+    }
+}
 
-An "opponent" node of the search tree.
+/*
+Returns the evaluator's score of the Board, from the perspective of
+the `color` player.
+*/
+template <typename Evaluator>
+inline BoardScore evaluate(SearchContext<Evaluator>* context,
+                           const Board& board, PieceColor color) {
+    ++context->counters.num_evaluations;
+    BoardScore score = context->evaluator(board, context->root_color);
+    ASSERT(score >= -player::computer::MAX_SCORE
+           && score <= player::computer::MAX_SCORE,
+           "score out of bounds: " + std::to_string(score));
+    return (color == context->root_color) ? score : -score;
+}
 
-@param board: the board to evaluate.
-@param color: the color of the maximizing player.
-@param depth_remaining: must be >= 0
+/*
+Looks up the Board in the tablebases of a context, and counts a hit.
+@param ply: distance from the root.
+@param score: set to the score of the Board from the perspective of the
+              `color` player, who is to move, iff it's found.
 */
-BoardScore alphaBetaSearchMin(Board* board, PieceColor color,
-                           std::size_t depth_remaining,
-                           BoardScore alpha, BoardScore beta,
-                           BoardHeuristicFunc board_heuristic,
-                           IScoreCache* score_cache);
+template <typename Evaluator>
+inline bool probeTablebases(SearchContext<Evaluator>* context,
+                            const Board& board, PieceColor color,
+                            std::size_t ply, BoardScore* score) {
+    int value;
+    if (context->tablebases == nullptr
+            || !context->tablebases->probe(board, color, &value)) {
+        return false;
+    }
+    ++context->counters.num_tablebase_hits;
+    if (value > 0) {
+        *score = getWinScore(ply + value);
+    } else if (value < 0) {
+        *score = -getWinScore(ply - value);
+    } else {
+        *score = evaluate(context, board, color);
+    }
+    return true;
+}
 
 /*
-The "machinery" of the alphaBetaSearch variants.
-
-@param board: the board to evaluate.
-@param color: the color of the maximizing player.
-@param depth_remaining: must be >= 0
-@param heuristic_eval_color: the color "perspective" from which the board
-           is evaluated. (i.e. if color == WHITE, the heuristic
-           (should) assign greater value to WHITE-preferential boards.).
-@param score_init: the initial value of the board's score.
-@param child_eval_variant: either alphaBetaSearchMin or alphaBetaSearchMax.
-           This is the function used to evaluate any child nodes.
-@param score_update: given the current score and a child node's score,
-           returns an updated score for the current node.
-@param exit_cond: returns true iff children no longer need to be evaluated.
-@param bound_update: updates alpha and/or beta.
+Returns true iff the position at `ply` (whose key must be set) repeats
+an earlier position of its line, or of the game.
 */
-BoardScore alphaBetaSearchBase(Board* board, PieceColor color,
-                            std::size_t depth_remaining,
-                            BoardScore alpha, BoardScore beta,
-                            BoardHeuristicFunc board_heuristic,
-                            PieceColor heuristic_eval_color,
-                            BoardScore score_init,
-                            AlphaBetaVariantFunc child_eval_variant,
-                            ScoreUpdateFunc score_update,
-                            ExitCondFunc exit_cond,
-                            BoundUpdateFunc bound_update,
-                            IScoreCache* score_cache) {
-    ASSERT(depth_remaining >= 0,
-            "must have non-negative depth_remaining; depth_remaining: "
-            + std::to_string(depth_remaining));
-
-    // TODO(theimer): make this a separate function
-    // TODO(theimer): possible recomputation of cache index below
-    BoardScore* score_ptr = score_cache->find(*board, depth_remaining);
-    if (score_ptr != score_cache->end()) {
-        return *score_ptr;
-    }
-
-    if (depth_remaining == 0) {
-        // leaf node!
-        BoardScore score = board_heuristic(*board, heuristic_eval_color);
-        score_cache->set(*board, depth_remaining, score);
-        return score;
+template <typename Evaluator>
+inline bool isRepetition(const SearchContext<Evaluator>* context,
+                         std::size_t ply) {
+    std::size_t key = context->line_keys[ply];
+    // the same player is to move every other ply
+    for (std::size_t distance = 2;
+            distance <= context->reversible_plies[ply]; distance += 2) {
+        std::size_t earlier_key = (distance <= ply)
+                ? context->line_keys[ply - distance]
+                : (*context->history)[context->history->size()
+                                      - (distance - ply)];
+        if (earlier_key == key) {
+            return true;
+        }
     }
+    return false;
+}
 
-    util::Buffer<Move, game::MAX_NUM_MOVES_PLY> move_buffer;
-    std::size_t num_moves =
-            game::getAllMoves(*board, color, move_buffer.start());
+/*
+Returns the score of the Board from the perspective of the `color`
+player, who is to move, searching only captures.
 
-    // TODO(theimer): unsure if this is actually needed
-    if (num_moves == 0) {
-        BoardScore score = board_heuristic(*board, heuristic_eval_color);
-        score_cache->set(*board, depth_remaining, score);
-        return score;
+The score is exact if it's within (alpha, beta). Otherwise, it's a
+bound: the true score is <= alpha or >= beta, respectively.
+
+@param ply: distance from the root.
+*/
+template <typename Evaluator>
+BoardScore quiescence(SearchContext<Evaluator>* context, Board* board,
+                      PieceColor color, std::size_t ply,
+                      BoardScore alpha, BoardScore beta) {
+    countNode(context);
+    ++context->counters.num_quiescence_nodes;
+    if (context->stop->load(std::memory_order_relaxed)) {
+        return 0;
     }
 
-    // start evaluating children...
-    BoardScore score = score_init;
-    for (std::size_t i = 0; i < num_moves; ++i) {
-        // Temporarily make a Move and store any "killed" opponent piece.
-        Move move = move_buffer.get(i);
-        std::optional<Piece> overwritten_piece_opt =
-                game::makeMove(board, move);
-
-        // Evaluate the Board that results from the Move.
-        // Note: Children are evaluated with the opposite color
-        //     and (depth_remaining - 1)
-        BoardScore child_score =
-                child_eval_variant(board, board::oppositeColor(color),
-                                   depth_remaining - 1, alpha, beta,
-                                   board_heuristic, score_cache);
-
-        // Update the current Board's score.
-        score = score_update(score, child_score);
-
-        // "unmake" the temporary move
-        game::unmakeMove(board, move, overwritten_piece_opt);
-
-        // check if an alpha/beta cutoff has been reached
-        if (exit_cond(alpha, beta, score)) {
-            break;
+    if (hasLostKing(*board, color)) {
+        return -getWinScore(ply);
+    }
+
+    BoardScore tablebase_score;
+    if (probeTablebases(context, *board, color, ply, &tablebase_score)) {
+        return tablebase_score;
+    }
+
+    // Every entry (at any draft) is at least as deep as a quiescence search.
+    TTEntry entry;
+    if (probe(context, *board, color, ply, &entry)
+            && (entry.bound == ScoreBound::EXACT
+                || (entry.bound == ScoreBound::LOWER && entry.score >= beta)
+                || (entry.bound == ScoreBound::UPPER
+                    && entry.score <= alpha))) {
+        return entry.score;
+    }
+
+    // stand pat
+    BoardScore best_score = evaluate(context, *board, color);
+    if (best_score >= beta) {
+        return best_score;
+    }
+    const BoardScore alpha_orig = alpha;
+    alpha = std::max(alpha, best_score);
+
+    MovePicker move_picker(*board, color);
+    CompressedMove best_move = game::EMPTY_COMPRESSED_MOVE;
+    for (CompressedMove move = move_picker.next();
+            move != game::EMPTY_COMPRESSED_MOVE; move = move_picker.next()) {
+        game::UndoInfo undo_info = game::makeMove(board, move);
+        BoardScore score = -quiescence(context, board,
+                                       board::oppositeColor(color), ply + 1,
+                                       -beta, -alpha);
+        game::unmakeMove(board, move, undo_info);
+
+        if (context->stop->load(std::memory_order_relaxed)) {
+            return 0;
         }
 
-        // no cutoff; simply update alpha and/or beta,
-        //     then keep evaluating children
-        bound_update(&alpha, &beta, score);
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
     }
 
-    score_cache->set(*board, depth_remaining, score);
-    return score;
+    ScoreBound bound = ScoreBound::EXACT;
+    if (best_score <= alpha_orig) {
+        bound = ScoreBound::UPPER;
+    } else if (best_score >= beta) {
+        bound = ScoreBound::LOWER;
+    }
+    store(context, *board, color, ply, best_score, best_move, 0, bound);
+    return best_score;
 }
 
-BoardScore alphaBetaSearchMax(Board* board, PieceColor color,
-                           std::size_t depth_remaining,
-                           BoardScore alpha, BoardScore beta,
-                           BoardHeuristicFunc board_heuristic,
-                           IScoreCache* score_cache) {
+/*
+Returns the score of the Board from the perspective of the `color`
+player, who is to move.
 
-    // Assume the worst-possible score.
-    BoardScore score_init = std::numeric_limits<BoardScore>::min();
+The score is exact if it's within (alpha, beta). Otherwise, it's a
+bound: the true score is <= alpha or >= beta, respectively.
 
-    // children are evaluated as minimizers (i.e. opponents)
-    AlphaBetaVariantFunc child_eval_variant = alphaBetaSearchMin;
+@param ply: distance from the root.
+@param depth_remaining: must be >= 0; must be > 0 at the ROOT.
+                        The search continues with quiescence() at 0.
+*/
+template <NodeType NODE, typename Evaluator>
+BoardScore negamax(SearchContext<Evaluator>* context, Board* board,
+                   PieceColor color, std::size_t ply,
+                   std::size_t depth_remaining,
+                   BoardScore alpha, BoardScore beta) {
+    constexpr bool IS_ROOT = NODE == NodeType::ROOT;
+    constexpr bool IS_PV = NODE != NodeType::NON_PV;
+    if (IS_PV) {
+        context->pv_lengths[ply] = 0;
+    }
 
-    // this node of the search wants to maximize its score
-    ScoreUpdateFunc score_update = [](BoardScore score, BoardScore child_score){
-        return std::max(score, child_score);
-    };
+    // the game is over; the root always has a king, though
+    if (!IS_ROOT && hasLostKing(*board, color)) {
+        return -getWinScore(ply);
+    }
 
-    /*
-    If the current node's score is at least beta (i.e. the minimum score at
-    some minimizing parent node), then we're done evaluating this node and its
-    children. The opponent can prevent the player from ever reaching this node,
-    so we disregard it in the search.
-    */
-    ExitCondFunc exit_cond =  [](BoardScore alpha, BoardScore beta,
-                                 BoardScore score) {
-        UNUSED(alpha);
-        return score >= beta;
-    };
+    // a repeated position is a draw; the root needs a move, though
+    context->line_keys[ply] = game::getPositionKey(*board, color);
+    if (!IS_ROOT && isRepetition(context, ply)) {
+        return evaluate(context, *board, color);
+    }
+
+    if (!IS_ROOT && depth_remaining == 0) {
+        // leaf node!
+        return quiescence(context, board, color, ply, alpha, beta);
+    }
+
+    countNode(context);
+    if (context->stop->load(std::memory_order_relaxed)) {
+        return 0;
+    }
+
+    // mate-distance pruning: nothing here beats capturing the opposing
+    //     king with the next move, or is worse than losing the king now
+    if (!IS_ROOT) {
+        alpha = std::max(alpha, -getWinScore(ply));
+        beta = std::min(beta, getWinScore(ply + 1));
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+
+    // the root needs a move, not just a score
+    BoardScore tablebase_score;
+    if (!IS_ROOT && probeTablebases(context, *board, color, ply,
+                                    &tablebase_score)) {
+        return tablebase_score;
+    }
+
+    TTEntry entry;
+    CompressedMove tt_move = game::EMPTY_COMPRESSED_MOVE;
+    if (probe(context, *board, color, ply, &entry)) {
+        tt_move = entry.best_move;
+        if (!IS_PV && entry.draft >= depth_remaining
+                && (entry.bound == ScoreBound::EXACT
+                    || (entry.bound == ScoreBound::LOWER
+                        && entry.score >= beta)
+                    || (entry.bound == ScoreBound::UPPER
+                        && entry.score <= alpha))) {
+            return entry.score;
+        }
+    }
+
+    // Null-move pruning (see player/computer/pruning.h). Never twice in
+    //     a row (i.e. that would search the same Board again), and only
+    //     with a piece besides the king and pawns, since passing might
+    //     truly be best otherwise (i.e. zugzwang).
+    if (!IS_PV && context->pruning.null_move_min_depth > 0
+            && depth_remaining >= context->pruning.null_move_min_depth
+            && !context->null_moves[ply]
+            && hasPieces(*board, color)
+            && evaluate(context, *board, color) >= beta) {
+        std::size_t reduction = std::min(
+                context->pruning.null_move_reduction, depth_remaining - 1);
+        context->null_moves[ply + 1] = true;
+        context->reversible_plies[ply + 1] = 0;
+        BoardScore score = -negamax<NodeType::NON_PV>(
+                context, board, board::oppositeColor(color), ply + 1,
+                depth_remaining - 1 - reduction, -beta, -beta + 1);
+        context->null_moves[ply + 1] = false;
+        if (context->stop->load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        if (score >= beta) {
+            // a win found after passing isn't proven; it's just >= beta
+            return (score >= player::computer::MIN_WIN_SCORE) ? beta : score;
+        }
+    }
 
-    // store the "player's best-possible score"
-    BoundUpdateFunc bound_update =
-            [](BoardScore* alpha, BoardScore* beta, BoardScore score) {
-        UNUSED(beta);
-        *alpha = std::max(*alpha, score);
+    // Moves are generated in stages as they're needed;
+    //     see player/computer/movepicker.h.
+    // The root instead searches its (ordered) root moves.
+    MovePicker move_picker(*board, color,
+                           IS_ROOT ? game::EMPTY_COMPRESSED_MOVE : tt_move,
+                           context->move_ordering, ply);
+    std::size_t root_index = 0;
+    auto nextMove = [&]() {
+        if (IS_ROOT) {
+            return (root_index < context->root_moves.size())
+                    ? context->root_moves[root_index++].move
+                    : game::EMPTY_COMPRESSED_MOVE;
+        }
+        return move_picker.next();
     };
+    CompressedMove move = nextMove();
 
-    PieceColor heuristic_eval_color = color;
+    if (move == game::EMPTY_COMPRESSED_MOVE) {
+        BoardScore score = evaluate(context, *board, color);
+        store(context, *board, color, ply, score,
+              game::EMPTY_COMPRESSED_MOVE, depth_remaining,
+              ScoreBound::EXACT);
+        return score;
+    }
 
-    return alphaBetaSearchBase(board, color, depth_remaining, alpha, beta,
-                               board_heuristic, heuristic_eval_color,
-                               score_init, child_eval_variant, score_update,
-                               exit_cond, bound_update, score_cache);
-}
+    const BoardScore alpha_orig = alpha;
+    BoardScore best_score = -player::computer::MAX_SCORE;
+    CompressedMove best_move = game::EMPTY_COMPRESSED_MOVE;
+    if (IS_ROOT) {
+        context->root_best_moves.clear();
+    }
 
-BoardScore alphaBetaSearchMin(Board* board, PieceColor color,
-                           std::size_t depth_remaining,
-                           BoardScore alpha, BoardScore beta,
-                           BoardHeuristicFunc board_heuristic,
-                           IScoreCache* score_cache) {
+    std::size_t move_index = 0;
+    for (; move != game::EMPTY_COMPRESSED_MOVE;
+            move = nextMove(), ++move_index) {
+        bool first_move = move_index == 0;
+
+        // At the root, a child that fails low only proves its score is
+        //     <= alpha, which can't tell a tie from a worse move.
+        //     Lowering alpha by one (scores are integers) keeps every
+        //     tie exact.
+        BoardScore child_alpha =
+                (IS_ROOT && !first_move) ? alpha - 1 : alpha;
+
+        game::UndoInfo undo_info = game::makeMove(board, move);
+        context->reversible_plies[ply + 1] = game::isCaptureMove(move)
+                ? 0 : context->reversible_plies[ply] + 1;
+        BoardScore score;
+        bool searched_pv = IS_PV && first_move;
+        if (searched_pv) {
+            score = -negamax<NodeType::PV>(context, board,
+                                           board::oppositeColor(color),
+                                           ply + 1, depth_remaining - 1,
+                                           -beta, -child_alpha);
+        } else {
+            // late move reductions (see player/computer/pruning.h)
+            std::size_t reduction = 0;
+            if (!IS_ROOT && !game::isCaptureMove(move)) {
+                reduction = context->reductions.get(depth_remaining,
+                                                    move_index);
+            }
+            score = -negamax<NodeType::NON_PV>(context, board,
+                                               board::oppositeColor(color),
+                                               ply + 1,
+                                               depth_remaining - 1 - reduction,
+                                               -child_alpha - 1,
+                                               -child_alpha);
+            if (reduction > 0 && score > child_alpha
+                    && !context->stop->load(std::memory_order_relaxed)) {
+                score = -negamax<NodeType::NON_PV>(
+                        context, board, board::oppositeColor(color), ply + 1,
+                        depth_remaining - 1, -child_alpha - 1, -child_alpha);
+            }
+            // not worse after all; find its exact score
+            if (IS_PV && score > child_alpha && score < beta
+                    && !context->stop->load(std::memory_order_relaxed)) {
+                searched_pv = true;
+                score = -negamax<NodeType::PV>(context, board,
+                                               board::oppositeColor(color),
+                                               ply + 1, depth_remaining - 1,
+                                               -beta, -child_alpha);
+            }
+        }
+        game::unmakeMove(board, move, undo_info);
 
+        // the child's score can't be trusted after a stop
+        if (context->stop->load(std::memory_order_relaxed)) {
+            return 0;
+        }
 
-    // Assume the opponent's worst-possible score (i.e. the max
-    //     score possible for the player)
-    BoardScore score_init = std::numeric_limits<BoardScore>::max();
+        if (IS_ROOT) {
+            RootMove& root_move = context->root_moves[root_index - 1];
+            root_move.score = score;
+            if (score > best_score) {
+                context->root_best_moves.clear();
+            }
+            if (score >= best_score) {
+                context->root_best_moves.push_back(move);
+                root_move.pv.assign(1, move);
+                if (searched_pv) {
+                    root_move.pv.insert(root_move.pv.end(), context->pv[1],
+                                        context->pv[1]
+                                        + context->pv_lengths[1]);
+                }
+            }
+        }
 
-    // children are evaluated as maximizers (i.e. the "player's" turn)
-    AlphaBetaVariantFunc child_eval_variant = alphaBetaSearchMax;
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+            if (score > alpha) {
+                alpha = score;
+                if (IS_PV) {
+                    // this move, then the child's line
+                    context->pv[ply][0] = move;
+                    std::size_t child_length = searched_pv
+                            ? context->pv_lengths[ply + 1] : 0;
+                    std::copy(context->pv[ply + 1],
+                              context->pv[ply + 1] + child_length,
+                              context->pv[ply] + 1);
+                    context->pv_lengths[ply] = 1 + child_length;
+                }
+                if (alpha >= beta) {
+                    ++context->counters.num_cutoffs;
+                    ++context->counters.num_cutoffs_by_move_index[
+                            std::min(move_index,
+                                     player::computer::NUM_CUTOFF_MOVE_INDICES
+                                     - 1)];
+                    context->move_ordering.updateCutoff(color, move, ply,
+                                                        depth_remaining);
+                    break;
+                }
+            }
+        }
+    }
 
-    // these "opponent" nodes want to find the minimum-possible
-    //     score for the player.
-    ScoreUpdateFunc score_update = [](BoardScore score, BoardScore child_score){
-        return std::min(score, child_score);
-    };
+    ScoreBound bound = ScoreBound::EXACT;
+    if (best_score <= alpha_orig) {
+        bound = ScoreBound::UPPER;
+    } else if (best_score >= beta) {
+        bound = ScoreBound::LOWER;
+    }
+    store(context, *board, color, ply, best_score, best_move,
+          depth_remaining, bound);
+    return best_score;
+}
 
-    /*
-    If the current node's score is less than alpha (i.e. the maximum score at
-    some maximizing parent node), then we're done evaluating this node and its
-    children. The maximizer (i.e. non-opponent player) can prevent the
-    minimizer from ever reaching this node, so we disregard it in the search.
-    */
-    ExitCondFunc exit_cond =  [](BoardScore alpha, BoardScore beta,
-                                 BoardScore score) {
-        UNUSED(beta);
-        return score <= alpha;
-    };
+/*
+Searches the root to `depth` with an aspiration window around
+`previous_score` (i.e. the score of the previous iteration), widening
+the window until the score falls inside it.
 
+Returns the score of the root, from the perspective of its player; it's
+meaningless if the search is stopped.
 
-    // store the "player's worst-possible score"
-    BoundUpdateFunc bound_update =
-            [](BoardScore* alpha, BoardScore* beta, BoardScore score) {
-        UNUSED(alpha);
-        *beta = std::min(*beta, score);
-    };
+@param has_previous_score: if false, the full window is searched.
+                          So is a previous win or loss, since its
+                          score is far from any other.
+*/
+template <typename Evaluator>
+BoardScore searchRoot(SearchContext<Evaluator>* context, Board* board,
+                      PieceColor color, std::size_t depth,
+                      bool has_previous_score, BoardScore previous_score) {
+    BoardScore delta = ASPIRATION_DELTA;
+    BoardScore alpha = -MAX_SCORE;
+    BoardScore beta = MAX_SCORE;
+    if (has_previous_score
+            && std::abs(previous_score) < player::computer::MIN_WIN_SCORE) {
+        alpha = std::max(previous_score - delta, -MAX_SCORE);
+        beta = std::min(previous_score + delta, MAX_SCORE);
+    }
+    while (true) {
+        BoardScore score = negamax<NodeType::ROOT>(context, board, color, 0,
+                                                   depth, alpha, beta);
+        if (context->stop->load(std::memory_order_relaxed)) {
+            return score;
+        }
+        delta *= 2;
+        if (score <= alpha && alpha > -MAX_SCORE) {
+            alpha = std::max(score - delta, -MAX_SCORE);
+        } else if (score >= beta && beta < MAX_SCORE) {
+            beta = std::min(score + delta, MAX_SCORE);
+        } else {
+            return score;
+        }
+    }
+}
 
-    // evaluate the board from the perspective of the maximizing player--
-    //     this is the score the minimizer wants to minimize.
-    PieceColor heuristic_eval_color = board::oppositeColor(color);
+/*
+A Lazy SMP helper thread: searches the root at increasing depths,
+starting at `depth`, until `stop` is set (or MAX_SEARCH_DEPTH is
+searched). Its results only reach the main search through the
+(shared) transposition table.
 
-    return alphaBetaSearchBase(board, color, depth_remaining, alpha, beta,
-                               board_heuristic, heuristic_eval_color,
-                               score_init, child_eval_variant, score_update,
-                               exit_cond, bound_update, score_cache);
+@param counters: set to the counts of the helper once it's done.
+*/
+template <typename Evaluator>
+void helperSearch(const Board& board, PieceColor color,
+                  const std::vector<std::size_t>* history, std::size_t depth,
+                  const PruningParams& pruning, const Evaluator& evaluator,
+                  ITranspositionTable* transposition_table,
+                  const Tablebases* tablebases,
+                  std::atomic<bool>* stop,
+                  std::atomic<std::size_t>* shared_num_nodes,
+                  SearchCounters* counters) {
+    Board board_copy(board);
+    SearchContext<Evaluator> context(evaluator, transposition_table,
+                                     tablebases, stop, shared_num_nodes,
+                                     color, pruning, history);
+    initRootMoves(&context, board_copy, color);
+    bool has_score = false;
+    BoardScore score = 0;
+    for (; depth <= player::computer::MAX_SEARCH_DEPTH
+            && !stop->load(std::memory_order_relaxed); ++depth) {
+        score = searchRoot(&context, &board_copy, color, depth, has_score,
+                           score);
+        has_score = true;
+        orderRootMoves(&context);
+    }
+    *counters = context.counters;
 }
 
+}  // namespace
+
 /*
 Also see the documentation in the header file.
-
-This is the "root" call of the search tree (i.e. a "friendly" node).
 */
-Move player::computer::alphaBetaSearch(
+template <typename Evaluator>
+CompressedMove player::computer::negamaxSearch(
                            const Board& board, PieceColor color,
-                           std::size_t depth,
-                           BoardHeuristicFunc board_heuristic,
-                           IScoreCache* score_cache) {
-    // this implementation is different enough from the alphaBetaSearch
-    //     variants that it isn't processed thru  alphaBetaSearchBase
-
-    ASSERT(depth > 0,
-            "must have positive depth; depth: " + std::to_string(depth));
+                           const std::vector<std::size_t>* history,
+                           const SearchLimits& limits,
+                           const PruningParams& pruning,
+                           const Evaluator& evaluator,
+                           ITranspositionTable* transposition_table,
+                           const Tablebases* tablebases,
+                           std::size_t num_threads,
+                           bool randomize_ties,
+                           const StopToken* stop_token,
+                           SearchStats* stats,
+                           std::vector<CompressedMove>* principal_variation) {
+    ASSERT(limits.max_depth > 0 && limits.max_depth <= MAX_SEARCH_DEPTH,
+            "invalid max_depth: " + std::to_string(limits.max_depth));
+    ASSERT(num_threads > 0, "must have at least one thread");
+
+    Clock::time_point start_time = Clock::now();
 
     // Doesn't make sense to accept a Board* for a search function,
     //     so we copy-construct a non-const version here.
     Board board_copy(board);
 
-    util::Buffer<Move, game::MAX_NUM_MOVES_PLY> move_buffer;
-    std::size_t num_moves =
-            game::getAllMoves(board_copy, color, move_buffer.start());
+    // entries from earlier searches become the first to be replaced
+    transposition_table->newSearch();
+
+    std::atomic<bool> stop(false);
+    std::atomic<std::size_t> shared_num_nodes(0);
+    SearchContext<Evaluator> context(evaluator, transposition_table,
+                                     tablebases, &stop, &shared_num_nodes,
+                                     color, pruning, history);
+    context.max_nodes = limits.max_nodes;
+    context.stop_token = stop_token;
+    context.has_hard_deadline = limits.hard_time.count() > 0;
+    context.hard_deadline = start_time + limits.hard_time;
+    initRootMoves(&context, board_copy, color);
+    ASSERT(!context.root_moves.empty(), "no moves to choose from");
+
+    // Lazy SMP: the helpers search the same root and share what they
+    //     find through the transposition table. Odd-numbered helpers
+    //     start a ply deeper, so the threads don't all walk the same
+    //     tree in lockstep.
+    std::vector<std::thread> helpers;
+    std::vector<SearchCounters> helper_counters(num_threads - 1);
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        helpers.emplace_back(helperSearch<Evaluator>, std::cref(board), color,
+                             history, 1 + (i % 2), std::cref(pruning),
+                             std::cref(evaluator), transposition_table,
+                             tablebases, &stop, &shared_num_nodes,
+                             &helper_counters[i - 1]);
+    }
 
-    // This is nearly the same implementation as alphaBetaSearchMax,
-    //     but all highest-scoring moves are stored in a vector.
-    std::vector<Move> best_moves;
-    BoardScore alpha = std::numeric_limits<BoardScore>::min();
-    for (std::size_t i = 0; i < num_moves; ++i) {
-        Move move = move_buffer.get(i);
-        std::optional<Piece> overwritten_opt =
-                game::makeMove(&board_copy, move);
-        BoardScore score = alphaBetaSearchMin(
-                             &board_copy, board::oppositeColor(color),
-                             depth - 1, alpha,
-                             std::numeric_limits<BoardScore>::max(),  // beta
-                             board_heuristic, score_cache);
-        game::unmakeMove(&board_copy, move, overwritten_opt);
-        if (score > alpha) {
-            // new highest score found; clear out the others.
-            alpha = score;
-            best_moves.clear();
-            best_moves.push_back(move);
-        } else if (score == alpha) {
-            best_moves.push_back(move);
+    std::vector<RootMove> best_moves;
+    BoardScore score = 0;
+    std::vector<IterationStats> iterations;
+    for (std::size_t depth = 1; depth <= limits.max_depth; ++depth) {
+        score = searchRoot(&context, &board_copy, color, depth, depth > 1,
+                           score);
+        if (stop.load(std::memory_order_relaxed)) {
+            // interrupted; the previous iteration's moves stand
+            break;
+        }
+        iterations.push_back(IterationStats{
+            depth, context.counters.num_nodes,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - start_time)
+        });
+        best_moves.clear();
+        for (const RootMove& root_move : context.root_moves) {
+            if (std::find(context.root_best_moves.begin(),
+                          context.root_best_moves.end(), root_move.move)
+                    != context.root_best_moves.end()) {
+                best_moves.push_back(root_move);
+            }
+        }
+        orderRootMoves(&context);
+
+        // a move is in hand, so the hard limits may interrupt from now on
+        context.enforce_limits = true;
+        if ((limits.soft_time.count() > 0
+                    && Clock::now() - start_time >= limits.soft_time)
+                || (stop_token != nullptr
+                    && stop_token->isStopRequested())) {
+            break;
         }
     }
 
+    // the main search decides the move; the helpers are done
+    stop.store(true, std::memory_order_relaxed);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    if (stats != nullptr) {
+        stats->depth = iterations.empty() ? 0 : iterations.back().depth;
+        stats->elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - start_time);
+        stats->threads.assign(1, context.counters);
+        stats->threads.insert(stats->threads.end(), helper_counters.begin(),
+                              helper_counters.end());
+        stats->total = SearchCounters();
+        for (const SearchCounters& counters : stats->threads) {
+            stats->total.add(counters);
+        }
+        stats->iterations = iterations;
+        stats->hashfull = transposition_table->getHashfull();
+    }
+
     // choose randomly from the vector, since they're all equally good
-    return best_moves[rand() % best_moves.size()];
+    ASSERT(!best_moves.empty(), "no moves to choose from");
+    const RootMove& chosen = randomize_ties
+            ? best_moves[rand() % best_moves.size()]
+            : best_moves.front();
+    if (principal_variation != nullptr) {
+        *principal_variation = chosen.pv;
+    }
+    return chosen.move;
+}
+
+template CompressedMove
+player::computer::negamaxSearch<BasicBoardEvaluator>(
+        const Board& board, PieceColor color,
+        const std::vector<std::size_t>* history, const SearchLimits& limits,
+        const PruningParams& pruning,
+        const BasicBoardEvaluator& evaluator,
+        ITranspositionTable* transposition_table,
+        const Tablebases* tablebases, std::size_t num_threads,
+        bool randomize_ties, const StopToken* stop_token, SearchStats* stats,
+        std::vector<CompressedMove>* principal_variation);
+template CompressedMove
+player::computer::negamaxSearch<HeuristicFuncEvaluator>(
+        const Board& board, PieceColor color,
+        const std::vector<std::size_t>* history, const SearchLimits& limits,
+        const PruningParams& pruning,
+        const HeuristicFuncEvaluator& evaluator,
+        ITranspositionTable* transposition_table,
+        const Tablebases* tablebases, std::size_t num_threads,
+        bool randomize_ties, const StopToken* stop_token, SearchStats* stats,
+        std::vector<CompressedMove>* principal_variation);
+
+CompressedMove player::computer::alphaBetaSearch(
+                           const Board& board, PieceColor color,
+                           std::size_t depth,
+                           BoardHeuristicFunc board_heuristic,
+                           ITranspositionTable* transposition_table,
+                           std::size_t num_threads) {
+    SearchLimits limits{ depth, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    return negamaxSearch(board, color, nullptr, limits,
+                         player::computer::NO_PRUNING_PARAMS,
+                         HeuristicFuncEvaluator(board_heuristic),
+                         transposition_table, nullptr, num_threads, true,
+                         nullptr, nullptr, nullptr);
+}
+
+void SearchCounters::add(const SearchCounters& other) {
+    num_nodes += other.num_nodes;
+    num_quiescence_nodes += other.num_quiescence_nodes;
+    num_evaluations += other.num_evaluations;
+    num_tt_probes += other.num_tt_probes;
+    num_tt_hits += other.num_tt_hits;
+    num_tt_stores += other.num_tt_stores;
+    num_tt_overwrites += other.num_tt_overwrites;
+    num_cutoffs += other.num_cutoffs;
+    num_tablebase_hits += other.num_tablebase_hits;
+    for (std::size_t i = 0; i < player::computer::NUM_CUTOFF_MOVE_INDICES;
+            ++i) {
+        num_cutoffs_by_move_index[i] += other.num_cutoffs_by_move_index[i];
+    }
+}
+
+double SearchStats::getFirstMoveCutoffRate() const {
+    return (total.num_cutoffs == 0) ? 0
+            : static_cast<double>(total.num_cutoffs_by_move_index[0])
+              / total.num_cutoffs;
+}
+
+double SearchStats::getEffectiveBranchingFactor() const {
+    return (depth == 0) ? 0
+            : std::pow(static_cast<double>(total.num_nodes), 1.0 / depth);
+}
+
+double SearchStats::getNodesPerSecond() const {
+    return (elapsed.count() == 0) ? 0
+            : total.num_nodes * 1e6 / elapsed.count();
 }
 
 BoardScore player::computer::basicBoardHeuristic(const Board& board,
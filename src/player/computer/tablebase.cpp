@@ -0,0 +1,727 @@
+// Copyright 2021 Alex Theimer
+
+#include "player/computer/tablebase.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "game/attacks.h"
+#include "util/assert.h"
+#include "util/bitops.h"
+
+using board::Bitboard;
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+using board::SquareIndex;
+using player::computer::MAX_TABLEBASE_PIECES;
+using player::computer::Tablebases;
+
+namespace {
+
+// identifies (this version of) the table format
+constexpr char TABLE_MAGIC[8] = { 'C', 'H', 'E', 'S', 'S', 'T', 'B', '1' };
+constexpr char TABLE_EXTENSION[] = ".tb";
+
+struct TableHeader {
+    char magic[8];
+    // the table's name, null-terminated
+    char name[16];
+    uint64_t num_entries;
+};
+
+static_assert(sizeof(TableHeader) == 32, "TableHeader must be packed");
+
+// the longest distance a table can hold
+constexpr std::size_t MAX_DISTANCE = INT8_MAX;
+
+// bits of a position's index per piece
+constexpr std::size_t SQUARE_BITS = 6;
+
+// pieces besides kings, most valuable first
+constexpr char PIECE_LETTERS[] = "QRBNP";
+constexpr PieceType PIECE_TYPES[] = { PieceType::QUEEN, PieceType::ROOK,
+                                      PieceType::BISHOP, PieceType::KNIGHT,
+                                      PieceType::PAWN };
+
+/*
+The pieces of a table: each side's pieces besides its king, by their
+index in PIECE_TYPES (i.e. most valuable first, once sorted).
+*/
+struct Material {
+    std::vector<std::size_t> pieces[2];
+
+    std::size_t getNumPieces() const {
+        return 2 + pieces[0].size() + pieces[1].size();
+    }
+};
+
+std::size_t getPieceRank(PieceType type) {
+    for (std::size_t i = 0; i < sizeof(PIECE_TYPES) / sizeof(PieceType);
+            ++i) {
+        if (PIECE_TYPES[i] == type) {
+            return i;
+        }
+    }
+    throw std::invalid_argument("unhandled PieceType: "
+                                + std::to_string(type));
+}
+
+/*
+Parses a table name (see Tablebases), in any order.
+@throws std::invalid_argument if the name is invalid.
+*/
+Material parseName(const std::string& name) {
+    Material material;
+    std::size_t side = 0;
+    bool expect_king = true;
+    for (char letter : name) {
+        if (expect_king) {
+            if (letter != 'K') {
+                throw std::invalid_argument("invalid table name: " + name);
+            }
+            expect_king = false;
+        } else if (letter == 'v' && side == 0) {
+            side = 1;
+            expect_king = true;
+        } else {
+            const char* found = std::strchr(PIECE_LETTERS, letter);
+            if (letter == '\0' || found == nullptr) {
+                throw std::invalid_argument("invalid table name: " + name);
+            }
+            material.pieces[side].push_back(found - PIECE_LETTERS);
+        }
+    }
+    if (side != 1 || expect_king) {
+        throw std::invalid_argument("invalid table name: " + name);
+    }
+    if (material.getNumPieces() > MAX_TABLEBASE_PIECES) {
+        throw std::invalid_argument("too many pieces: " + name);
+    }
+    return material;
+}
+
+std::string getName(const Material& material) {
+    std::string name;
+    for (std::size_t side = 0; side < 2; ++side) {
+        name += (side == 0) ? "K" : "vK";
+        for (std::size_t rank : material.pieces[side]) {
+            name += PIECE_LETTERS[rank];
+        }
+    }
+    return name;
+}
+
+/*
+Sorts each side's pieces, then lists the stronger side first (see
+Tablebases).
+@param swapped: set to true iff the sides were swapped.
+@return: the name of the table.
+*/
+std::string canonicalize(Material* material, bool* swapped) {
+    for (std::vector<std::size_t>& pieces : material->pieces) {
+        std::sort(pieces.begin(), pieces.end());
+    }
+    const std::vector<std::size_t>& first = material->pieces[0];
+    const std::vector<std::size_t>& second = material->pieces[1];
+    *swapped = second.size() > first.size()
+               || (second.size() == first.size() && second < first);
+    if (*swapped) {
+        std::swap(material->pieces[0], material->pieces[1]);
+    }
+    return getName(*material);
+}
+
+/*
+The pieces of a table, in the order their squares are indexed: the first
+side's king, the other side's king, the first side's pieces, then the
+other side's pieces.
+*/
+struct Layout {
+    std::size_t num_pieces;
+    PieceType types[MAX_TABLEBASE_PIECES];
+    std::size_t sides[MAX_TABLEBASE_PIECES];
+
+    explicit Layout(const Material& material) : num_pieces(0) {
+        for (std::size_t side = 0; side < 2; ++side) {
+            add(PieceType::KING, side);
+        }
+        for (std::size_t side = 0; side < 2; ++side) {
+            for (std::size_t rank : material.pieces[side]) {
+                add(PIECE_TYPES[rank], side);
+            }
+        }
+    }
+
+    void add(PieceType type, std::size_t side) {
+        types[num_pieces] = type;
+        sides[num_pieces] = side;
+        ++num_pieces;
+    }
+};
+
+std::size_t getNumEntries(std::size_t num_pieces) {
+    return std::size_t(2) << (SQUARE_BITS * num_pieces);
+}
+
+/*
+@param side_to_move: 0 for the table's first side, 1 for the other.
+*/
+std::size_t getIndex(std::size_t side_to_move, const SquareIndex* squares,
+                     std::size_t num_pieces) {
+    std::size_t index = side_to_move;
+    for (std::size_t i = 0; i < num_pieces; ++i) {
+        index = (index << SQUARE_BITS) | squares[i];
+    }
+    return index;
+}
+
+/*
+Reverses getIndex.
+@return: the side to move.
+*/
+std::size_t decodeIndex(std::size_t index, SquareIndex* squares,
+                        std::size_t num_pieces) {
+    for (std::size_t i = num_pieces; i-- > 0;) {
+        squares[i] = index & ((1 << SQUARE_BITS) - 1);
+        index >>= SQUARE_BITS;
+    }
+    return index;
+}
+
+/*
+Returns the squares a piece attacks (see game/attacks.h).
+*/
+Bitboard getAttacks(PieceType type, SquareIndex index, Bitboard occupancy) {
+    switch (type) {
+    case PieceType::KING:
+    case PieceType::PAWN:
+        return game::getKingAttacks(index);
+    case PieceType::KNIGHT:
+        return game::getKnightAttacks(index);
+    case PieceType::BISHOP:
+        return game::getBishopAttacks(index, occupancy);
+    case PieceType::ROOK:
+        return game::getRookAttacks(index, occupancy);
+    case PieceType::QUEEN:
+        return game::getQueenAttacks(index, occupancy);
+    default:
+        throw std::invalid_argument("unhandled PieceType: "
+                                    + std::to_string(type));
+    }
+}
+
+/*
+Runs func(thread_index, begin, end) over [0, num_items), split into
+contiguous ranges among `num_threads` threads (the calling thread
+included).
+*/
+template <typename Func>
+void parallelFor(std::size_t num_items, std::size_t num_threads, Func func) {
+    if (num_items == 0) {
+        return;
+    }
+    std::size_t chunk = (num_items + num_threads - 1) / num_threads;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        std::size_t begin = std::min(num_items, i * chunk);
+        std::size_t end = std::min(num_items, begin + chunk);
+        threads.emplace_back(func, i, begin, end);
+    }
+    func(0, 0, std::min(num_items, chunk));
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+/*
+How the position after a capture is found in a smaller table.
+*/
+struct CaptureTable {
+    const int8_t* values;
+    // the remaining pieces, by their index in the larger table's Layout,
+    //     in the order of the smaller table's Layout
+    std::size_t order[MAX_TABLEBASE_PIECES - 1];
+    // true iff the smaller table lists the sides the other way around
+    bool swapped;
+};
+
+/*
+The state of one table's retrograde analysis (see Tablebases::generate).
+*/
+class Generator {
+ public:
+    Generator(const Material& material, std::size_t num_threads) :
+            layout_(material), num_entries_(getNumEntries(layout_.num_pieces)),
+            num_threads_(num_threads),
+            values_(new std::atomic<int8_t>[num_entries_]),
+            num_unresolved_(new std::atomic<uint8_t>[num_entries_]),
+            loss_floors_(new uint8_t[num_entries_]),
+            captures_(), scheduled_(MAX_DISTANCE + 2) {
+        // intentionally blank
+    }
+
+    /*
+    @param index: of a piece of the Layout besides the kings.
+    */
+    void setCaptureTable(std::size_t index, const CaptureTable& table) {
+        captures_[index] = table;
+    }
+
+    /*
+    Resolves every position, then returns the value of each.
+    @throws std::runtime_error if a distance exceeds MAX_DISTANCE.
+    */
+    std::vector<int8_t> run() {
+        std::vector<std::vector<Scheduled>> thread_scheduled(num_threads_);
+        parallelFor(num_entries_, num_threads_,
+                    [&](std::size_t thread, std::size_t begin,
+                        std::size_t end) {
+            for (std::size_t index = begin; index < end; ++index) {
+                initPosition(index, &thread_scheduled[thread]);
+            }
+        });
+        mergeScheduled(&thread_scheduled);
+
+        std::vector<uint32_t> frontier;
+        std::vector<std::vector<uint32_t>> thread_frontiers(num_threads_);
+        for (std::size_t distance = 1; ; ++distance) {
+            bool has_scheduled = false;
+            for (std::size_t later = distance; later < scheduled_.size();
+                    ++later) {
+                has_scheduled |= !scheduled_[later].empty();
+            }
+            if (frontier.empty() && !has_scheduled) {
+                break;
+            }
+            if (distance > MAX_DISTANCE) {
+                throw std::runtime_error("distance too long for a table");
+            }
+
+            // positions resolved before any step (i.e. by captures)
+            const std::vector<uint32_t>& ready = scheduled_[distance];
+            parallelFor(ready.size(), num_threads_,
+                        [&](std::size_t thread, std::size_t begin,
+                            std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    resolve(ready[i], distance, &thread_frontiers[thread]);
+                }
+            });
+            parallelFor(frontier.size(), num_threads_,
+                        [&](std::size_t thread, std::size_t begin,
+                            std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    unmakeMoves(frontier[i], distance,
+                                &thread_frontiers[thread],
+                                &thread_scheduled[thread]);
+                }
+            });
+            mergeScheduled(&thread_scheduled);
+            frontier.clear();
+            for (std::vector<uint32_t>& thread_frontier : thread_frontiers) {
+                frontier.insert(frontier.end(), thread_frontier.begin(),
+                                thread_frontier.end());
+                thread_frontier.clear();
+            }
+        }
+
+        std::vector<int8_t> values(num_entries_);
+        for (std::size_t index = 0; index < num_entries_; ++index) {
+            values[index] = values_[index].load(std::memory_order_relaxed);
+        }
+        return values;
+    }
+
+ private:
+    // a position to resolve at a distance known in advance
+    struct Scheduled {
+        std::size_t distance;
+        uint32_t index;
+    };
+
+    void mergeScheduled(std::vector<std::vector<Scheduled>>* thread_scheduled) {
+        for (std::vector<Scheduled>& scheduled : *thread_scheduled) {
+            for (const Scheduled& entry : scheduled) {
+                scheduled_[entry.distance].push_back(entry.index);
+            }
+            scheduled.clear();
+        }
+    }
+
+    /*
+    Returns the value of the position after piece `captured` is captured,
+    for the player to move then.
+    @param squares: the squares after the capture (i.e. the capturing
+                    piece is on the captured piece's square).
+    */
+    int8_t getCaptureValue(std::size_t side_to_move,
+                           const SquareIndex* squares,
+                           std::size_t captured) const {
+        const CaptureTable& table = captures_[captured];
+        SquareIndex child_squares[MAX_TABLEBASE_PIECES - 1];
+        for (std::size_t i = 0; i < layout_.num_pieces - 1; ++i) {
+            child_squares[i] = squares[table.order[i]];
+        }
+        std::size_t child_side = 1 - side_to_move;
+        if (table.swapped) {
+            child_side = 1 - child_side;
+        }
+        return table.values[getIndex(child_side, child_squares,
+                                     layout_.num_pieces - 1)];
+    }
+
+    /*
+    Counts a position's moves, and schedules it if its captures
+    already decide it.
+    */
+    void initPosition(std::size_t index, std::vector<Scheduled>* scheduled) {
+        values_[index].store(0, std::memory_order_relaxed);
+        num_unresolved_[index].store(0, std::memory_order_relaxed);
+        loss_floors_[index] = 0;
+
+        SquareIndex squares[MAX_TABLEBASE_PIECES];
+        std::size_t side_to_move = decodeIndex(index, squares,
+                                               layout_.num_pieces);
+        Bitboard occupancy = 0;
+        Bitboard own = 0;
+        for (std::size_t i = 0; i < layout_.num_pieces; ++i) {
+            Bitboard bit = Bitboard(1) << squares[i];
+            if (occupancy & bit) {
+                // two pieces on one square; never reached
+                return;
+            }
+            occupancy |= bit;
+            if (layout_.sides[i] == side_to_move) {
+                own |= bit;
+            }
+        }
+
+        std::size_t num_moves = 0;
+        std::size_t num_unresolved = 0;
+        std::size_t win_distance = 0;
+        std::size_t loss_floor = 0;
+        for (std::size_t i = 0; i < layout_.num_pieces; ++i) {
+            if (layout_.sides[i] != side_to_move) {
+                continue;
+            }
+            Bitboard targets = getAttacks(layout_.types[i], squares[i],
+                                          occupancy) & ~own;
+            while (targets > 0) {
+                SquareIndex target = util::popLowestBit(&targets);
+                ++num_moves;
+                if (!(occupancy & (Bitboard(1) << target))) {
+                    ++num_unresolved;
+                    continue;
+                }
+                std::size_t captured = 0;
+                while (squares[captured] != target) {
+                    ++captured;
+                }
+                std::size_t distance = 0;
+                if (layout_.types[captured] == PieceType::KING) {
+                    distance = 1;
+                } else {
+                    SquareIndex from = squares[i];
+                    squares[i] = target;
+                    int8_t value = getCaptureValue(side_to_move, squares,
+                                                   captured);
+                    squares[i] = from;
+                    if (value > 0) {
+                        // a won position for the opponent
+                        loss_floor = std::max(loss_floor,
+                                              std::size_t(value) + 1);
+                        continue;
+                    }
+                    ++num_unresolved;
+                    if (value < 0) {
+                        distance = 1 - value;
+                    }
+                }
+                if (distance > 0 && (win_distance == 0
+                                     || distance < win_distance)) {
+                    win_distance = distance;
+                }
+            }
+        }
+
+        num_unresolved_[index].store(num_unresolved, std::memory_order_relaxed);
+        loss_floors_[index] = loss_floor;
+        if (win_distance > 0) {
+            scheduled->push_back(Scheduled{ win_distance, uint32_t(index) });
+        } else if (num_moves > 0 && num_unresolved == 0) {
+            scheduled->push_back(Scheduled{ loss_floor, uint32_t(index) });
+        }
+    }
+
+    /*
+    Sets an unresolved position's value: won at an odd distance, lost
+    at an even one.
+    */
+    void resolve(uint32_t index, std::size_t distance,
+                 std::vector<uint32_t>* frontier) {
+        int8_t value = (distance % 2 == 1) ? int8_t(distance)
+                                           : -int8_t(distance);
+        int8_t unresolved = 0;
+        if (values_[index].compare_exchange_strong(
+                unresolved, value, std::memory_order_relaxed)) {
+            frontier->push_back(index);
+        }
+    }
+
+    /*
+    Updates the predecessors of a position resolved at `distance - 1`
+    (i.e. the positions that reach it with a move besides a capture).
+    */
+    void unmakeMoves(uint32_t index, std::size_t distance,
+                     std::vector<uint32_t>* frontier,
+                     std::vector<Scheduled>* scheduled) {
+        bool lost = values_[index].load(std::memory_order_relaxed) < 0;
+        SquareIndex squares[MAX_TABLEBASE_PIECES];
+        std::size_t side_to_move = decodeIndex(index, squares,
+                                               layout_.num_pieces);
+        // the player who made the move
+        std::size_t mover = 1 - side_to_move;
+        Bitboard occupancy = 0;
+        for (std::size_t i = 0; i < layout_.num_pieces; ++i) {
+            occupancy |= Bitboard(1) << squares[i];
+        }
+
+        for (std::size_t i = 0; i < layout_.num_pieces; ++i) {
+            if (layout_.sides[i] != mover) {
+                continue;
+            }
+            SquareIndex from = squares[i];
+            // every piece moves the same way in both directions
+            Bitboard sources = getAttacks(layout_.types[i], from, occupancy)
+                               & ~occupancy;
+            while (sources > 0) {
+                squares[i] = util::popLowestBit(&sources);
+                uint32_t previous = getIndex(mover, squares,
+                                             layout_.num_pieces);
+                if (lost) {
+                    resolve(previous, distance, frontier);
+                } else if (num_unresolved_[previous].fetch_sub(
+                                   1, std::memory_order_relaxed) == 1) {
+                    // every move of `previous` leads to a won position
+                    std::size_t loss_distance =
+                            std::max<std::size_t>(distance,
+                                                  loss_floors_[previous]);
+                    if (loss_distance == distance) {
+                        resolve(previous, distance, frontier);
+                    } else {
+                        scheduled->push_back(Scheduled{ loss_distance,
+                                                        previous });
+                    }
+                }
+            }
+            squares[i] = from;
+        }
+    }
+
+    const Layout layout_;
+    const std::size_t num_entries_;
+    const std::size_t num_threads_;
+    // 0 until resolved (see Tablebases)
+    std::unique_ptr<std::atomic<int8_t>[]> values_;
+    // moves not yet known to lead to a won position (for the opponent)
+    std::unique_ptr<std::atomic<uint8_t>[]> num_unresolved_;
+    // the least distance a position can be lost at, given its captures
+    std::unique_ptr<uint8_t[]> loss_floors_;
+    CaptureTable captures_[MAX_TABLEBASE_PIECES];
+    // positions to resolve, by distance
+    std::vector<std::vector<uint32_t>> scheduled_;
+};
+
+std::string getTablePath(const std::string& directory,
+                         const std::string& name) {
+    return (std::filesystem::path(directory) / (name + TABLE_EXTENSION))
+            .string();
+}
+
+}  // namespace
+
+Tablebases::Tablebases(const std::string& directory) :
+        tables_(), max_pieces_(0) {
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() != TABLE_EXTENSION) {
+            continue;
+        }
+        std::string path = entry.path().string();
+        Table table;
+        table.file = std::make_unique<util::MappedFile>(path);
+        const util::MappedFile& file = *table.file;
+        if (file.size() < sizeof(TableHeader)) {
+            throw std::runtime_error("not a table: " + path);
+        }
+        const TableHeader* header =
+                reinterpret_cast<const TableHeader*>(file.data());
+        std::string name(header->name,
+                         strnlen(header->name, sizeof(header->name)));
+        if (std::memcmp(header->magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0
+                || entry.path().stem() != name) {
+            throw std::runtime_error("not a table: " + path);
+        }
+        Material material = parseName(name);
+        bool swapped;
+        if (canonicalize(&material, &swapped) != name
+                || header->num_entries
+                   != getNumEntries(material.getNumPieces())
+                || file.size() != sizeof(TableHeader)
+                                  + header->num_entries) {
+            throw std::runtime_error("not a table: " + path);
+        }
+        table.values = reinterpret_cast<const int8_t*>(header + 1);
+        max_pieces_ = std::max(max_pieces_, material.getNumPieces());
+        tables_[name] = std::move(table);
+    }
+}
+
+std::size_t Tablebases::getMaxPieces() const {
+    return max_pieces_;
+}
+
+bool Tablebases::probe(const Board& board, PieceColor color,
+                       int* value) const {
+    Bitboard occupancy = board.getOccupancyBitboard();
+    // the common case by far
+    if (static_cast<std::size_t>(__builtin_popcountll(occupancy))
+            > max_pieces_) {
+        return false;
+    }
+    // each color's king, then its other pieces by (rank, square)
+    SquareIndex kings[2] = { 0, 0 };
+    std::size_t num_kings[2] = { 0, 0 };
+    std::vector<std::pair<std::size_t, SquareIndex>> pieces[2];
+    while (occupancy > 0) {
+        SquareIndex index = util::popLowestBit(&occupancy);
+        Piece piece = board.getPiece(Square::indexToSquare(index));
+        std::size_t side = static_cast<std::size_t>(piece.color);
+        if (piece.type == PieceType::KING) {
+            kings[side] = index;
+            ++num_kings[side];
+        } else {
+            pieces[side].emplace_back(getPieceRank(piece.type), index);
+        }
+    }
+    if (num_kings[0] != 1 || num_kings[1] != 1) {
+        return false;
+    }
+
+    Material material;
+    for (std::size_t side = 0; side < 2; ++side) {
+        std::sort(pieces[side].begin(), pieces[side].end());
+        for (const auto& piece : pieces[side]) {
+            material.pieces[side].push_back(piece.first);
+        }
+    }
+    bool swapped;
+    auto found = tables_.find(canonicalize(&material, &swapped));
+    if (found == tables_.end()) {
+        return false;
+    }
+
+    // the colors, in the order of the table's sides
+    std::size_t sides[2] = { 0, 1 };
+    if (swapped) {
+        std::swap(sides[0], sides[1]);
+    }
+    SquareIndex squares[MAX_TABLEBASE_PIECES];
+    std::size_t num_squares = 0;
+    squares[num_squares++] = kings[sides[0]];
+    squares[num_squares++] = kings[sides[1]];
+    for (std::size_t side : sides) {
+        for (const auto& piece : pieces[side]) {
+            squares[num_squares++] = piece.second;
+        }
+    }
+    std::size_t side_to_move =
+            (static_cast<std::size_t>(color) == sides[0]) ? 0 : 1;
+    *value = found->second.values[getIndex(side_to_move, squares,
+                                           num_squares)];
+    return true;
+}
+
+void Tablebases::generate(const std::string& name,
+                          const std::string& directory,
+                          std::size_t num_threads) {
+    ASSERT(num_threads > 0, "must have at least one thread");
+    Material material = parseName(name);
+    bool swapped;
+    std::string table_name = canonicalize(&material, &swapped);
+    std::filesystem::create_directories(directory);
+
+    // every table reached by a capture must exist first
+    Layout layout(material);
+    struct Capture {
+        std::size_t captured;
+        std::string name;
+        bool swapped;
+    };
+    std::vector<Capture> captures;
+    for (std::size_t captured = 2; captured < layout.num_pieces; ++captured) {
+        Material smaller = material;
+        std::size_t side = layout.sides[captured];
+        std::size_t offset = (side == 0) ? captured - 2
+                : captured - 2 - material.pieces[0].size();
+        smaller.pieces[side].erase(smaller.pieces[side].begin() + offset);
+        bool smaller_swapped;
+        std::string smaller_name = canonicalize(&smaller, &smaller_swapped);
+        if (!std::filesystem::exists(getTablePath(directory, smaller_name))) {
+            generate(smaller_name, directory, num_threads);
+        }
+        captures.push_back(Capture{ captured, smaller_name, smaller_swapped });
+    }
+
+    Tablebases smaller_tables(directory);
+    Generator generator(material, num_threads);
+    for (const Capture& capture : captures) {
+        CaptureTable table;
+        table.values = smaller_tables.tables_.at(capture.name).values;
+        table.swapped = capture.swapped;
+        // the remaining pieces keep their order within each side
+        std::vector<std::size_t> order[2];
+        for (std::size_t i = 0; i < layout.num_pieces; ++i) {
+            if (i != capture.captured) {
+                order[layout.sides[i]].push_back(i);
+            }
+        }
+        if (table.swapped) {
+            std::swap(order[0], order[1]);
+        }
+        // kings first
+        std::size_t num_ordered = 0;
+        table.order[num_ordered++] = order[0][0];
+        table.order[num_ordered++] = order[1][0];
+        for (const std::vector<std::size_t>& side_order : order) {
+            for (std::size_t i = 1; i < side_order.size(); ++i) {
+                table.order[num_ordered++] = side_order[i];
+            }
+        }
+        generator.setCaptureTable(capture.captured, table);
+    }
+    std::vector<int8_t> values = generator.run();
+
+    TableHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    std::memcpy(header.name, table_name.c_str(), table_name.size());
+    header.num_entries = values.size();
+    std::string path = getTablePath(directory, table_name);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(values.data()), values.size());
+    file.close();
+    if (!file) {
+        throw std::runtime_error("cannot write table: " + path);
+    }
+}
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <vector>
 
 using board::Board;
 using board::Square;
@@ -43,7 +44,8 @@ player::Human::Human(std::string name) : Player(name) {
     // intentionally blank
 }
 
-Move player::Human::getMove(const Board& board, board::PieceColor color) {
+Move player::Human::getMove(const Board& board, board::PieceColor color,
+                            const std::vector<std::size_t>&) {
     Move move = promptPlayerForMove();
     while (!game::isValidMove(board, color, move)) {
         std::cout << "Invalid move!" << std::endl;
@@ -0,0 +1,48 @@
+// Copyright 2021 Alex Theimer
+
+#include "util/mappedfile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+
+util::MappedFile::MappedFile(const std::string& path) :
+        mapping_(nullptr), size_(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open: " + path);
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        throw std::runtime_error("cannot stat: " + path);
+    }
+    size_ = status.st_size;
+    // mmap rejects empty mappings
+    if (size_ > 0) {
+        mapping_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // the mapping outlives the descriptor
+    close(fd);
+    if (mapping_ == MAP_FAILED) {
+        throw std::runtime_error("cannot map: " + path);
+    }
+}
+
+util::MappedFile::~MappedFile() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, size_);
+    }
+}
+
+const uint8_t* util::MappedFile::data() const {
+    return static_cast<const uint8_t*>(mapping_);
+}
+
+std::size_t util::MappedFile::size() const {
+    return size_;
+}
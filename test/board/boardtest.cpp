@@ -36,10 +36,13 @@ getPiece
     square: (0,0), (0,7) (7,0), (7,7), other
     piece: {all piece types/colors}
     board: single piece, multiple pieces
-removePiece  // TODO(theimer): add these tests!
+removePiece
     square: (0,0), (0,7) (7,0), (7,7), other
     piece: {all piece types/colors}
     board: single piece, multiple pieces
+movePieceCapture/unmovePieceCapture
+    to: empty, occupied by each piece type
+    moved/captured: same type, different type
 getOccupiedSquares
     board: single piece, no pieces, multiple pieces
     board: occupied squares at (0,0), (0,7) (7,0), (7,7), other
@@ -252,6 +255,124 @@ TEST(BoardTest, MoveTest) {
     }
 }
 
+/*
+Instantiates Boards each with a set of Pieces, then removes each Piece
+one-by-one via Board::removePiece. After every removal, confirms
+Board::getPiece and Board::squareIsOccupied return the expected results.
+
+Covers:
+    removePiece
+        square: (0,0), (0,7) (7,0), (7,7), other
+        piece: {all piece types/colors}
+        board: single piece, multiple pieces
+*/
+TEST(BoardTest, RemoveTest) {
+    std::vector<std::unordered_map<Square, Piece>> piece_maps = {
+        {{Square(0, 0), Piece{PieceType::KING, PieceColor::BLACK}}},
+        {
+            {Square(0, 0), Piece{PieceType::QUEEN, PieceColor::WHITE}},
+            {Square(0, 7), Piece{PieceType::BISHOP, PieceColor::WHITE}},
+            {Square(7, 0), Piece{PieceType::ROOK, PieceColor::BLACK}},
+            {Square(7, 7), Piece{PieceType::KNIGHT, PieceColor::WHITE}},
+        },
+        {
+            {Square(4, 5), Piece{PieceType::QUEEN, PieceColor::BLACK}},
+            {Square(0, 7), Piece{PieceType::KING, PieceColor::WHITE}},
+            {Square(6, 1), Piece{PieceType::PAWN, PieceColor::BLACK}},
+            {Square(3, 2), Piece{PieceType::PAWN, PieceColor::WHITE}},
+        },
+    };
+
+    for (auto& piece_map : piece_maps) {
+        Board board(piece_map);
+        // pieces are erased from the tracker as they're removed
+        std::unordered_map<Square, Piece> piece_tracker = piece_map;
+        for (auto pair : piece_map) {
+            board.removePiece(pair.first);
+            piece_tracker.erase(pair.first);
+            for (Square square : ALL_SQUARES) {
+                auto piece_iter = piece_tracker.find(square);
+                if (piece_iter != piece_tracker.end()) {
+                    // square is occupied!
+                    ASSERT_EQ(piece_iter->second, board.getPiece(square));
+                } else {
+                    // unoccupied
+                    ASSERT_FALSE(board.squareIsOccupied(square));
+                }
+            }
+        }
+    }
+}
+
+/*
+Applies Board::movePieceCapture to a Board, then confirms the result
+(including its hash) matches a Board constructed from scratch with the
+expected pieces. Then confirms Board::unmovePieceCapture restores the
+original Board.
+
+Covers:
+    movePieceCapture/unmovePieceCapture
+        to: empty, occupied by each piece type
+        moved/captured: same type, different type
+*/
+TEST(BoardTest, MoveCaptureTest) {
+    const std::unordered_map<Square, Piece> piece_map = {
+        {Square(0, 0), Piece{PieceType::QUEEN, PieceColor::WHITE}},
+        {Square(0, 7), Piece{PieceType::BISHOP, PieceColor::BLACK}},
+        {Square(7, 0), Piece{PieceType::ROOK, PieceColor::BLACK}},
+        {Square(7, 7), Piece{PieceType::KNIGHT, PieceColor::BLACK}},
+        {Square(3, 3), Piece{PieceType::QUEEN, PieceColor::BLACK}},
+        {Square(4, 4), Piece{PieceType::KING, PieceColor::BLACK}},
+        {Square(5, 5), Piece{PieceType::PAWN, PieceColor::BLACK}},
+    };
+    const std::vector<Square> to_squares = {
+        Square(2, 6), Square(0, 7), Square(7, 0), Square(7, 7),
+        Square(3, 3), Square(4, 4), Square(5, 5)
+    };
+
+    Square from = Square(0, 0);
+    for (Square to : to_squares) {
+        Board board(piece_map);
+        std::unordered_map<Square, Piece> expected_map = piece_map;
+        expected_map[to] = expected_map.at(from);
+        expected_map.erase(from);
+        Board expected(expected_map);
+
+        board::CompressedPiece captured = board.movePieceCapture(
+                Square::squareToIndex(from), Square::squareToIndex(to));
+        ASSERT_EQ(piece_map.find(to) == piece_map.end(),
+                  captured == board::EMPTY_COMPRESSED_PIECE);
+        ASSERT_EQ(std::hash<Board>{}(expected), std::hash<Board>{}(board));
+        for (Square square : ALL_SQUARES) {
+            ASSERT_EQ(expected.squareIsOccupied(square),
+                      board.squareIsOccupied(square));
+            if (expected.squareIsOccupied(square)) {
+                ASSERT_EQ(expected.getPiece(square), board.getPiece(square));
+            }
+        }
+
+        Board original(piece_map);
+        board.unmovePieceCapture(Square::squareToIndex(from),
+                                 Square::squareToIndex(to), captured);
+        ASSERT_EQ(std::hash<Board>{}(original), std::hash<Board>{}(board));
+        for (Square square : ALL_SQUARES) {
+            ASSERT_EQ(original.squareIsOccupied(square),
+                      board.squareIsOccupied(square));
+            if (original.squareIsOccupied(square)) {
+                ASSERT_EQ(original.getPiece(square), board.getPiece(square));
+            }
+            for (std::size_t icolor = 0;
+                    icolor < static_cast<std::size_t>(
+                                    PieceColor::NUM_PIECE_COLORS);
+                    ++icolor) {
+                PieceColor color = static_cast<PieceColor>(icolor);
+                ASSERT_EQ(original.squareIsOccupiedColor(square, color),
+                          board.squareIsOccupiedColor(square, color));
+            }
+        }
+    }
+}
+
 /*
 Instantiates Boards each with their own set of Pieces, then calls Board::getOccupiedSquares.
 Confirms result is expected.
@@ -0,0 +1,79 @@
+// Copyright 2021 Alex Theimer
+
+#include <unordered_set>
+
+#include "gtest/gtest.h"
+#include "board/zobhash.h"
+#include "board/square.h"
+#include "board/piece.h"
+
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+/*
+~~~ Test Partitions ~~~
+toggleZobPiece
+    piece: {all piece types/colors}
+    square: {all squares}
+toggleZobSideToMove/applyZobSideToMove
+    color: WHITE, BLACK
+*/
+
+/*
+Confirms every Piece/Square value (and the side-to-move key) is unique
+and that toggling twice restores the original hash.
+
+Covers:
+    toggleZobPiece
+        piece: {all piece types/colors}
+        square: {all squares}
+    toggleZobSideToMove
+*/
+TEST(ZobHashTest, UniqueKeysTest) {
+    std::unordered_set<std::size_t> keys;
+    for (std::size_t isquare = 0; isquare < Square::NUM_SQUARES; ++isquare) {
+        for (std::size_t itype = 0;
+                itype < static_cast<std::size_t>(PieceType::NUM_PIECE_TYPES);
+                ++itype) {
+            for (std::size_t icolor = 0;
+                    icolor < static_cast<std::size_t>(
+                                    PieceColor::NUM_PIECE_COLORS);
+                    ++icolor) {
+                Piece piece = { static_cast<PieceType>(itype),
+                                static_cast<PieceColor>(icolor) };
+                std::size_t hash =
+                        board::toggleZobPiece(board::ZOB_INIT, piece, isquare);
+                ASSERT_TRUE(keys.insert(hash).second);
+                ASSERT_EQ(board::ZOB_INIT,
+                          board::toggleZobPiece(hash, piece, isquare));
+            }
+        }
+    }
+    std::size_t side_hash = board::toggleZobSideToMove(board::ZOB_INIT);
+    ASSERT_TRUE(keys.insert(side_hash).second);
+    ASSERT_EQ(board::ZOB_INIT, board::toggleZobSideToMove(side_hash));
+}
+
+/*
+Hash values must never change between runs/builds (they may be written
+to disk), so pin a few of them.
+
+Covers:
+    toggleZobPiece
+    applyZobSideToMove
+        color: WHITE, BLACK
+*/
+TEST(ZobHashTest, FixedKeysTest) {
+    Piece black_king = { PieceType::KING, PieceColor::BLACK };
+    Piece white_bishop = { PieceType::BISHOP, PieceColor::WHITE };
+    ASSERT_EQ(0x9A133C88D1995DC2ULL,
+              board::toggleZobPiece(board::ZOB_INIT, black_king, 0));
+    ASSERT_EQ(0x3360E9DE020929D3ULL,
+              board::toggleZobPiece(board::ZOB_INIT, white_bishop, 63));
+    ASSERT_EQ(board::ZOB_INIT,
+              board::applyZobSideToMove(board::ZOB_INIT, PieceColor::BLACK));
+    ASSERT_EQ(0x91967936ABC01B3DULL,
+              board::applyZobSideToMove(board::ZOB_INIT, PieceColor::WHITE));
+}
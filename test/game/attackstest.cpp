@@ -0,0 +1,149 @@
+// Copyright 2021 Alex Theimer
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/attacks.h"
+
+using board::Bitboard;
+using board::Square;
+using board::SquareIndex;
+
+/*
+~~~ Test Partitions ~~~
+getKingAttacks/getKnightAttacks
+    square: corner, edge, other
+getRookAttacks/getBishopAttacks/getQueenAttacks
+    square: corner, edge, other
+    occupancy: empty, sparse, dense
+    occupancy: includes the attacking square, excludes the attacking square
+*/
+
+struct Diff {
+    int row_diff;
+    int col_diff;
+};
+
+/*
+Computes slider attacks by walking each ray one square at a time.
+(i.e. the "obviously-correct" reference implementation.)
+*/
+template <std::size_t SIZE>
+Bitboard walkRays(SquareIndex square_index, Bitboard occupancy,
+                  const std::array<Diff, SIZE>& diffs) {
+    Square square = Square::indexToSquare(square_index);
+    Bitboard attacks = 0;
+    for (Diff diff : diffs) {
+        std::size_t row = square.row + diff.row_diff;
+        std::size_t col = square.col + diff.col_diff;
+        while (Square::isValidDims(row, col)) {
+            Bitboard bit = static_cast<Bitboard>(1)
+                    << Square::squareToIndex(Square(row, col));
+            attacks |= bit;
+            if (occupancy & bit) {
+                break;
+            }
+            row += diff.row_diff;
+            col += diff.col_diff;
+        }
+    }
+    return attacks;
+}
+
+/*
+Computes step attacks by adding each Diff to the square.
+(i.e. the "obviously-correct" reference implementation.)
+*/
+template <std::size_t SIZE>
+Bitboard applyDiffs(SquareIndex square_index,
+                    const std::array<Diff, SIZE>& diffs) {
+    Square square = Square::indexToSquare(square_index);
+    Bitboard attacks = 0;
+    for (Diff diff : diffs) {
+        std::size_t row = square.row + diff.row_diff;
+        std::size_t col = square.col + diff.col_diff;
+        if (Square::isValidDims(row, col)) {
+            attacks |= static_cast<Bitboard>(1)
+                    << Square::squareToIndex(Square(row, col));
+        }
+    }
+    return attacks;
+}
+
+/*
+Compares each king/knight lookup against applyDiffs for every square.
+
+Covers:
+    getKingAttacks/getKnightAttacks
+        square: corner, edge, other
+*/
+TEST(AttacksTest, StepAttacksTest) {
+    static const std::array<Diff, 8> king_diffs = {{
+        { 1, 0 }, { 0, 1 }, { 1, 1 }, { -1, 0 },
+        { 0, -1 }, { -1, -1 }, { 1, -1 }, { -1, 1 }
+    }};
+    static const std::array<Diff, 8> knight_diffs = {{
+        { 2, 1 }, { 2, -1 }, { -2, 1 }, { -2, -1 },
+        { 1, 2 }, { 1, -2 }, { -1, 2 }, { -1, -2 }
+    }};
+
+    for (std::size_t i = 0; i < Square::NUM_SQUARES; ++i) {
+        SquareIndex index = i;
+        ASSERT_EQ(applyDiffs(index, king_diffs), game::getKingAttacks(index))
+                << "index: " << i;
+        ASSERT_EQ(applyDiffs(index, knight_diffs),
+                  game::getKnightAttacks(index))
+                << "index: " << i;
+    }
+}
+
+/*
+Compares each slider lookup against walkRays for every square at a
+range of random occupancies.
+
+Covers:
+    getRookAttacks/getBishopAttacks/getQueenAttacks
+        square: corner, edge, other
+        occupancy: empty, sparse, dense
+        occupancy: includes the attacking square, excludes the attacking square
+*/
+TEST(AttacksTest, SliderAttacksTest) {
+    static const std::array<Diff, 4> rook_diffs = {{
+        { 0, 1 }, { 1, 0 }, { -1, 0 }, { 0, -1 }
+    }};
+    static const std::array<Diff, 4> bishop_diffs = {{
+        { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+    }};
+    static const std::array<Diff, 8> queen_diffs = {{
+        { 0, 1 }, { 1, 0 }, { -1, 0 }, { 0, -1 },
+        { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+    }};
+
+    // fixed seed keeps failures reproducible
+    std::mt19937_64 rand_gen(1234);
+    std::vector<Bitboard> occupancies = { 0, ~static_cast<Bitboard>(0) };
+    for (int i = 0; i < 200; ++i) {
+        // AND-ing random values gives progressively sparser occupancies
+        occupancies.push_back(rand_gen());
+        occupancies.push_back(rand_gen() & rand_gen());
+        occupancies.push_back(rand_gen() & rand_gen() & rand_gen());
+    }
+
+    for (Bitboard occupancy : occupancies) {
+        for (std::size_t i = 0; i < Square::NUM_SQUARES; ++i) {
+            SquareIndex index = i;
+            ASSERT_EQ(walkRays(index, occupancy, rook_diffs),
+                      game::getRookAttacks(index, occupancy))
+                      << "index: " << i << ", occupancy: " << occupancy;
+            ASSERT_EQ(walkRays(index, occupancy, bishop_diffs),
+                      game::getBishopAttacks(index, occupancy))
+                      << "index: " << i << ", occupancy: " << occupancy;
+            ASSERT_EQ(walkRays(index, occupancy, queen_diffs),
+                      game::getQueenAttacks(index, occupancy))
+                      << "index: " << i << ", occupancy: " << occupancy;
+        }
+    }
+}
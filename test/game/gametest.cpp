@@ -0,0 +1,109 @@
+// Copyright 2021 Alex Theimer
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "game/move.h"
+
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+using game::Game;
+using game::Move;
+
+/*
+~~~ Test Partitions ~~~
+Game::runPly
+    move: capture, non-capture
+Game::isDrawn
+    position: occurred once, occurred NUM_REPETITIONS_DRAW times
+*/
+
+/*
+Plays a fixed sequence of moves, and records the size of each history
+it's given.
+*/
+class ScriptedPlayer : public game::Player {
+ public:
+    explicit ScriptedPlayer(const std::vector<Move>& moves) :
+            Player("scripted"), moves_(moves), history_sizes_() {
+        // intentionally blank
+    }
+
+    Move getMove(const Board&, PieceColor,
+                 const std::vector<std::size_t>& history) override {
+        Move move = moves_[history_sizes_.size()];
+        history_sizes_.push_back(history.size());
+        return move;
+    }
+
+    const std::vector<std::size_t>& getHistorySizes() const {
+        return history_sizes_;
+    }
+
+ private:
+    std::vector<Move> moves_;
+    std::vector<std::size_t> history_sizes_;
+};
+
+/*
+Covers:
+    Game::runPly
+        move: non-capture
+    Game::isDrawn
+        position: occurred once, occurred NUM_REPETITIONS_DRAW times
+*/
+TEST(GameTest, RepetitionTest) {
+    // the knights leave, then return, twice
+    Move black_out{ Square(0, 1), Square(2, 2) };
+    Move black_back{ Square(2, 2), Square(0, 1) };
+    Move white_out{ Square(7, 1), Square(5, 2) };
+    Move white_back{ Square(5, 2), Square(7, 1) };
+    ScriptedPlayer black({ black_out, black_back, black_out, black_back });
+    ScriptedPlayer white({ white_out, white_back, white_out, white_back });
+    Board board(game::INIT_PIECE_MAP);
+    Game game(&board, &white, &black);
+
+    for (std::size_t ply = 0; ply < 8; ++ply) {
+        ASSERT_FALSE(game.isEnded());
+        game.runPly();
+    }
+    ASSERT_TRUE(game.isEnded());
+    ASSERT_TRUE(game.isDrawn());
+    ASSERT_EQ((std::vector<std::size_t>{ 0, 2, 4, 6 }),
+              black.getHistorySizes());
+    ASSERT_EQ((std::vector<std::size_t>{ 1, 3, 5, 7 }),
+              white.getHistorySizes());
+}
+
+/*
+Covers:
+    Game::runPly
+        move: capture
+*/
+TEST(GameTest, CaptureHistoryTest) {
+    ScriptedPlayer black({ Move{ Square(3, 0), Square(3, 5) },
+                           Move{ Square(0, 0), Square(0, 1) } });
+    ScriptedPlayer white({ Move{ Square(7, 7), Square(7, 6) } });
+    Board board({
+        { Square(0, 0), Piece{ PieceType::KING, PieceColor::BLACK } },
+        { Square(3, 0), Piece{ PieceType::ROOK, PieceColor::BLACK } },
+        { Square(7, 7), Piece{ PieceType::KING, PieceColor::WHITE } },
+        { Square(3, 5), Piece{ PieceType::KNIGHT, PieceColor::WHITE } },
+    });
+    Game game(&board, &white, &black);
+
+    for (std::size_t ply = 0; ply < 3; ++ply) {
+        game.runPly();
+    }
+    // nothing before the capture can repeat
+    ASSERT_EQ((std::vector<std::size_t>{ 0, 1 }), black.getHistorySizes());
+    ASSERT_EQ((std::vector<std::size_t>{ 0 }), white.getHistorySizes());
+    ASSERT_FALSE(game.isEnded());
+}
@@ -0,0 +1,104 @@
+// Copyright 2021 Alex Theimer
+
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/move.h"
+#include "util/buffer.h"
+
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+using game::CompressedMove;
+using game::Move;
+
+/*
+~~~ Test Partitions ~~~
+compressMove/decompressMove
+    from: {all squares}
+    to: {all squares}
+getAllMoves
+    move: capture, non-capture
+    board: one piece, multiple pieces of both colors
+*/
+
+/*
+Compresses/decompresses every from/to Square pair, then compares the
+decompression result against the original Move.
+
+Covers:
+    compressMove/decompressMove
+        from: {all squares}
+        to: {all squares}
+*/
+TEST(MoveTest, CompressDecompressTest) {
+    for (std::size_t from = 0; from < Square::NUM_SQUARES; ++from) {
+        for (std::size_t to = 0; to < Square::NUM_SQUARES; ++to) {
+            Move move = { Square::indexToSquare(from),
+                          Square::indexToSquare(to) };
+            CompressedMove compressed = game::compressMove(move);
+            ASSERT_EQ(move, game::decompressMove(compressed));
+            ASSERT_EQ(from, game::getMoveFromIndex(compressed));
+            ASSERT_EQ(to, game::getMoveToIndex(compressed));
+            ASSERT_FALSE(game::isCaptureMove(compressed));
+        }
+    }
+}
+
+/*
+Generates all moves for a Board with a known set of moves, then confirms
+each is expected and flagged as a capture iff it lands on an enemy.
+
+Covers:
+    getAllMoves
+        move: capture, non-capture
+        board: one piece, multiple pieces of both colors
+*/
+TEST(MoveTest, GetAllMovesTest) {
+    // white rook in the corner, boxed in by a friendly pawn and an enemy
+    //     knight; the pawn moves like a king.
+    std::unordered_map<Square, Piece> piece_map = {
+        { Square(0, 0), Piece{ PieceType::ROOK, PieceColor::WHITE } },
+        { Square(0, 2), Piece{ PieceType::PAWN, PieceColor::WHITE } },
+        { Square(2, 0), Piece{ PieceType::KNIGHT, PieceColor::BLACK } },
+    };
+    Board board(piece_map);
+
+    struct Expected {
+        Move move;
+        bool capture;
+    };
+    std::vector<Expected> expected = {
+        { Move{ Square(0, 0), Square(0, 1) }, false },
+        { Move{ Square(0, 0), Square(1, 0) }, false },
+        { Move{ Square(0, 0), Square(2, 0) }, true },
+        { Move{ Square(0, 2), Square(0, 1) }, false },
+        { Move{ Square(0, 2), Square(0, 3) }, false },
+        { Move{ Square(0, 2), Square(1, 1) }, false },
+        { Move{ Square(0, 2), Square(1, 2) }, false },
+        { Move{ Square(0, 2), Square(1, 3) }, false },
+    };
+
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves =
+            game::getAllMoves(board, PieceColor::WHITE, move_buffer.start());
+    ASSERT_EQ(expected.size(), num_moves);
+    for (const Expected& exp : expected) {
+        bool found = false;
+        for (std::size_t i = 0; i < num_moves; ++i) {
+            CompressedMove move = move_buffer.get(i);
+            if (game::decompressMove(move) == exp.move) {
+                ASSERT_EQ(exp.capture, game::isCaptureMove(move))
+                        << exp.move;
+                found = true;
+            }
+        }
+        ASSERT_TRUE(found) << exp.move;
+        ASSERT_TRUE(game::isValidMove(board, PieceColor::WHITE, exp.move));
+    }
+}
@@ -0,0 +1,159 @@
+// Copyright 2021 Alex Theimer
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "game/move.h"
+#include "player/computer/book.h"
+
+using board::Board;
+using board::PieceColor;
+using board::Square;
+using game::CompressedMove;
+using game::Move;
+using player::computer::BookEntry;
+using player::computer::OpeningBook;
+using player::computer::OpeningBookBuilder;
+
+/*
+~~~ Test Partitions ~~~
+parseGameRecord
+    record: empty, complete moves, incomplete move, invalid square
+OpeningBookBuilder::addGame
+    max_plies: < number of moves, >= number of moves
+    moves: valid, contains an invalid move
+OpeningBook::getEntries
+    position: in book, out of book
+OpeningBook::pickMove
+    position: in book, out of book
+OpeningBook::OpeningBook
+    file: book, missing, not a book, num_entries too large
+*/
+
+static std::string getTempPath(const std::string& name) {
+    return testing::TempDir() + name;
+}
+
+/*
+Covers:
+    parseGameRecord
+        record: empty, complete moves, incomplete move, invalid square
+*/
+TEST(BookTest, ParseGameRecordTest) {
+    ASSERT_TRUE(player::computer::parseGameRecord("").empty());
+
+    std::vector<Move> moves =
+            player::computer::parseGameRecord("1 0 2 0\n6 7 5 6 ");
+    ASSERT_EQ(2u, moves.size());
+    ASSERT_EQ((Move{ Square(1, 0), Square(2, 0) }), moves[0]);
+    ASSERT_EQ((Move{ Square(6, 7), Square(5, 6) }), moves[1]);
+
+    ASSERT_THROW(player::computer::parseGameRecord("1 0 2"),
+                 std::invalid_argument);
+    ASSERT_THROW(player::computer::parseGameRecord("1 0 2 8"),
+                 std::invalid_argument);
+    ASSERT_THROW(player::computer::parseGameRecord("1 0 2 x"),
+                 std::invalid_argument);
+}
+
+/*
+Confirms a written book holds each recorded (position, move) pair,
+weighted by how often it was played, and nothing else.
+
+Covers:
+    OpeningBookBuilder::addGame
+        max_plies: < number of moves, >= number of moves
+        moves: valid, contains an invalid move
+    OpeningBook::getEntries
+        position: in book, out of book
+    OpeningBook::pickMove
+        position: in book, out of book
+    OpeningBook::OpeningBook
+        file: book
+*/
+TEST(BookTest, BuildAndProbeTest) {
+    Move black_a{ Square(1, 0), Square(2, 0) };
+    Move black_b{ Square(1, 7), Square(2, 7) };
+    Move white{ Square(6, 0), Square(5, 0) };
+
+    OpeningBookBuilder builder;
+    builder.addGame({ black_a, white, black_a }, 2);
+    builder.addGame({ black_a }, 2);
+    builder.addGame({ black_b, white }, 2);
+    // black can't move white's pawn
+    ASSERT_THROW(builder.addGame({ white }, 2), game::InvalidMoveEx);
+    ASSERT_EQ(4u, builder.size());
+
+    std::string path = getTempPath("booktest_build.bin");
+    builder.write(path);
+    OpeningBook book(path);
+    ASSERT_EQ(4u, book.size());
+
+    Board board(game::INIT_PIECE_MAP);
+    const BookEntry* entries;
+    ASSERT_EQ(2u, book.getEntries(board, game::START_COLOR, &entries));
+    ASSERT_LT(entries[0].move, entries[1].move);
+    for (std::size_t i = 0; i < 2; ++i) {
+        if (entries[i].move == game::compressMove(black_a)) {
+            ASSERT_EQ(2u, entries[i].weight);
+        } else {
+            ASSERT_EQ(game::compressMove(black_b), entries[i].move);
+            ASSERT_EQ(1u, entries[i].weight);
+        }
+    }
+    for (std::size_t i = 0; i < 20; ++i) {
+        CompressedMove move = book.pickMove(board, game::START_COLOR);
+        ASSERT_TRUE(move == game::compressMove(black_a)
+                    || move == game::compressMove(black_b));
+    }
+
+    // the same position, but the other player to move
+    PieceColor other = board::oppositeColor(game::START_COLOR);
+    ASSERT_EQ(0u, book.getEntries(board, other, &entries));
+    ASSERT_EQ(game::EMPTY_COMPRESSED_MOVE, book.pickMove(board, other));
+
+    game::makeMove(&board, game::compressMove(black_a));
+    ASSERT_EQ(1u, book.getEntries(board, other, &entries));
+    ASSERT_EQ(game::compressMove(white), entries[0].move);
+    ASSERT_EQ(1u, entries[0].weight);
+
+    // beyond max_plies
+    game::makeMove(&board, game::compressMove(white));
+    ASSERT_EQ(0u, book.getEntries(board, game::START_COLOR, &entries));
+}
+
+/*
+Covers:
+    OpeningBook::OpeningBook
+        file: missing, not a book, num_entries too large
+*/
+TEST(BookTest, InvalidFileTest) {
+    ASSERT_THROW(OpeningBook(getTempPath("booktest_missing.bin")),
+                 std::runtime_error);
+
+    std::string path = getTempPath("booktest_invalid.bin");
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "definitely not an opening book";
+    file.close();
+    ASSERT_THROW(OpeningBook{ path }, std::runtime_error);
+
+    // an empty book, claiming so many entries that their size overflows
+    //     (i.e. wraps to 0)
+    OpeningBookBuilder().write(path);
+    player::computer::BookHeader header;
+    std::fstream book_file(path, std::ios::binary | std::ios::in
+                                 | std::ios::out);
+    book_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    header.num_entries = (UINT64_MAX / sizeof(BookEntry)) + 1;
+    ASSERT_EQ(0u, header.num_entries * sizeof(BookEntry));
+    book_file.seekp(0);
+    book_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    book_file.close();
+    ASSERT_THROW(OpeningBook{ path }, std::runtime_error);
+}
@@ -0,0 +1,211 @@
+// Copyright 2021 Alex Theimer
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "player/computer/computer.h"
+#include "player/computer/search.h"
+
+using board::Board;
+using board::PieceColor;
+
+using player::Computer;
+using player::computer::SearchCounters;
+using player::computer::SearchLimits;
+using player::computer::SearchStats;
+
+/*
+~~~ Test Partitions ~~~
+Computer::Computer
+    hash_size_mib: power of two, not a power of two
+Computer::getMove
+    color: first search, same as the last search, other than the last
+Computer::getLastSearchStats
+    num_threads: 1, > 1
+Computer::stop
+    called: during getMove, right after getMove is called
+*/
+
+/*
+Confirms the stats of a search are consistent with each other: the
+total is the sum of the threads, every cutoff is counted by move index,
+and iterations complete in order.
+
+Covers:
+    Computer::getLastSearchStats
+        num_threads: 1, > 1
+*/
+TEST(ComputerTest, StatsTest) {
+    constexpr std::size_t DEPTH = 4;
+    SearchLimits limits{ DEPTH, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    for (std::size_t num_threads : { 1, 3 }) {
+        Board board(game::INIT_PIECE_MAP);
+        Computer computer("test", num_threads,
+                          player::DEFAULT_HASH_SIZE_MIB, true, limits,
+                          player::computer::DEFAULT_PRUNING_PARAMS,
+                          nullptr, nullptr);
+        computer.getMove(board, PieceColor::BLACK, {});
+        const SearchStats& stats = computer.getLastSearchStats();
+
+        ASSERT_EQ(DEPTH, stats.depth);
+        ASSERT_EQ(num_threads, stats.threads.size());
+        // helpers may be stopped before they get to run
+        ASSERT_GT(stats.threads[0].num_nodes, 0u);
+        SearchCounters sum = SearchCounters();
+        for (const SearchCounters& counters : stats.threads) {
+            sum.add(counters);
+        }
+        ASSERT_EQ(sum.num_nodes, stats.total.num_nodes);
+        ASSERT_EQ(sum.num_tt_probes, stats.total.num_tt_probes);
+
+        const SearchCounters& total = stats.total;
+        ASSERT_LE(total.num_quiescence_nodes, total.num_nodes);
+        ASSERT_GT(total.num_evaluations, 0u);
+        ASSERT_LE(total.num_tt_hits, total.num_tt_probes);
+        ASSERT_LE(total.num_tt_overwrites, total.num_tt_stores);
+        std::size_t num_cutoffs = 0;
+        for (std::size_t count : total.num_cutoffs_by_move_index) {
+            num_cutoffs += count;
+        }
+        ASSERT_EQ(total.num_cutoffs, num_cutoffs);
+
+        ASSERT_EQ(DEPTH, stats.iterations.size());
+        for (std::size_t i = 0; i < stats.iterations.size(); ++i) {
+            ASSERT_EQ(i + 1, stats.iterations[i].depth);
+            if (i > 0) {
+                ASSERT_GT(stats.iterations[i].num_nodes,
+                          stats.iterations[i - 1].num_nodes);
+                ASSERT_GE(stats.iterations[i].elapsed,
+                          stats.iterations[i - 1].elapsed);
+            }
+        }
+        ASSERT_LE(stats.iterations.back().elapsed, stats.elapsed);
+
+        ASSERT_GT(stats.hashfull, 0u);
+        ASSERT_LE(stats.hashfull, 1000u);
+        ASSERT_GT(stats.getEffectiveBranchingFactor(), 1.0);
+        ASSERT_GT(stats.getNodesPerSecond(), 0.0);
+    }
+}
+
+/*
+Confirms getMove returns soon after a stop, even without other limits.
+
+Covers:
+    Computer::stop
+        called: during getMove
+*/
+TEST(ComputerTest, StopTest) {
+    SearchLimits limits{ player::computer::MAX_SEARCH_DEPTH,
+                         std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    Board board(game::INIT_PIECE_MAP);
+    Computer computer("test", 1, player::DEFAULT_HASH_SIZE_MIB, true, limits,
+                      player::computer::DEFAULT_PRUNING_PARAMS,
+                      nullptr, nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread search([&]() {
+        computer.getMove(board, PieceColor::BLACK, {});
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    computer.stop();
+    search.join();
+    ASSERT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::seconds(1));
+    ASSERT_GE(computer.getLastSearchStats().depth, 1u);
+}
+
+/*
+Confirms a bigger table holds the same search more sparsely, and that
+sizes are rounded down to a power of two.
+
+Covers:
+    Computer::Computer
+        hash_size_mib: power of two, not a power of two
+*/
+TEST(ComputerTest, HashSizeTest) {
+    SearchLimits limits{ 6, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    Board board(game::INIT_PIECE_MAP);
+    std::vector<std::size_t> hashfulls;
+    for (std::size_t hash_size_mib : { 1, 3, 8 }) {
+        Computer computer("test", 1, hash_size_mib, false, limits,
+                          player::computer::DEFAULT_PRUNING_PARAMS,
+                          nullptr, nullptr);
+        computer.getMove(board, PieceColor::BLACK, {});
+        hashfulls.push_back(computer.getLastSearchStats().hashfull);
+    }
+    // 3 MiB rounds down to 2 MiB, i.e. half as dense as 1 MiB
+    ASSERT_NEAR(hashfulls[0] / 2.0, hashfulls[1], hashfulls[0] / 8.0);
+    ASSERT_GT(hashfulls[1], hashfulls[2]);
+    ASSERT_GT(hashfulls[2], 0u);
+}
+
+/*
+Confirms a search for one color is unaffected by an earlier search for
+the other color, but reuses an earlier search for the same color.
+
+Covers:
+    Computer::getMove
+        color: first search, same as the last search, other than the last
+*/
+TEST(ComputerTest, ColorChangeTest) {
+    SearchLimits limits{ 5, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    Board board(game::INIT_PIECE_MAP);
+    Computer fresh("fresh", 1, player::DEFAULT_HASH_SIZE_MIB, false, limits,
+                   player::computer::DEFAULT_PRUNING_PARAMS, nullptr, nullptr);
+    game::Move expected_move = fresh.getMove(board, PieceColor::BLACK, {});
+    std::size_t expected_num_nodes =
+            fresh.getLastSearchStats().total.num_nodes;
+
+    Computer computer("test", 1, player::DEFAULT_HASH_SIZE_MIB, false,
+                      limits, player::computer::DEFAULT_PRUNING_PARAMS,
+                      nullptr, nullptr);
+    computer.getMove(board, PieceColor::WHITE, {});
+    std::size_t first_num_nodes = computer.getLastSearchStats().total.num_nodes;
+    computer.getMove(board, PieceColor::WHITE, {});
+    // the second search starts from the first's entries
+    ASSERT_LT(computer.getLastSearchStats().total.num_nodes, first_num_nodes);
+    game::Move move = computer.getMove(board, PieceColor::BLACK, {});
+    ASSERT_EQ(expected_move.from, move.from);
+    ASSERT_EQ(expected_move.to, move.to);
+    ASSERT_EQ(expected_num_nodes,
+              computer.getLastSearchStats().total.num_nodes);
+}
+
+/*
+Confirms a stop isn't lost when it arrives before the search begins.
+
+Covers:
+    Computer::stop
+        called: right after getMove is called
+*/
+TEST(ComputerTest, EarlyStopTest) {
+    // (the hard limit only keeps a lost stop from hanging the test)
+    SearchLimits limits{ player::computer::MAX_SEARCH_DEPTH,
+                         std::chrono::milliseconds::zero(),
+                         std::chrono::seconds(10), 0 };
+    Board board(game::INIT_PIECE_MAP);
+    Computer computer("test", 1, player::DEFAULT_HASH_SIZE_MIB, true, limits,
+                      player::computer::DEFAULT_PRUNING_PARAMS,
+                      nullptr, nullptr);
+
+    for (std::size_t i = 0; i < 20; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        std::thread search([&]() {
+            computer.getMove(board, PieceColor::BLACK, {});
+        });
+        computer.stop();
+        search.join();
+        ASSERT_LT(std::chrono::steady_clock::now() - start,
+                  std::chrono::seconds(1));
+        ASSERT_GE(computer.getLastSearchStats().depth, 1u);
+    }
+}
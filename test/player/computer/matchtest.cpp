@@ -0,0 +1,140 @@
+// Copyright 2021 Alex Theimer
+
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "game/move.h"
+#include "player/computer/computer.h"
+#include "player/computer/match.h"
+
+using board::PieceColor;
+using board::Square;
+using game::Move;
+using player::computer::EngineConfig;
+using player::computer::MatchGameResult;
+using player::computer::MatchOptions;
+using player::computer::MatchResults;
+using player::computer::Sprt;
+using player::computer::SprtDecision;
+
+/*
+~~~ Test Partitions ~~~
+Sprt::Sprt
+    parameters: valid, elo0 >= elo1, error rate out of range
+Sprt::getDecision
+    results: favor H0, favor H1, undecided
+runMatch
+    openings: none, some, invalid
+    sprt: nullptr, decides before num_games
+    num_threads: 1, > 1
+*/
+
+static const EngineConfig ENGINE{
+        "test", player::DEFAULT_HASH_SIZE_MIB,
+        { 1, std::chrono::milliseconds::zero(),
+          std::chrono::milliseconds::zero(), 0 },
+        player::computer::DEFAULT_PRUNING_PARAMS };
+
+/*
+Covers:
+    Sprt::Sprt
+        parameters: valid, elo0 >= elo1, error rate out of range
+    Sprt::getDecision
+        results: favor H0, favor H1, undecided
+*/
+TEST(MatchTest, SprtTest) {
+    ASSERT_THROW(Sprt(10, 0, 0.05, 0.05), std::invalid_argument);
+    ASSERT_THROW(Sprt(0, 10, 0, 0.05), std::invalid_argument);
+    ASSERT_THROW(Sprt(0, 10, 0.05, 0.5), std::invalid_argument);
+
+    Sprt sprt(0, 20, 0.05, 0.05);
+    ASSERT_NEAR(std::log(0.05 / 0.95), sprt.getLowerBound(), 1e-9);
+    ASSERT_NEAR(std::log(0.95 / 0.05), sprt.getUpperBound(), 1e-9);
+
+    // a single game is never decisive
+    ASSERT_EQ(SprtDecision::CONTINUE, sprt.getDecision({ 1, 0, 0 }));
+    ASSERT_EQ(SprtDecision::CONTINUE, sprt.getDecision({ 0, 0, 1 }));
+    ASSERT_EQ(SprtDecision::CONTINUE, sprt.getDecision({ 50, 100, 50 }));
+    // +~52 Elo, then +0 Elo
+    ASSERT_EQ(SprtDecision::ACCEPT_H1, sprt.getDecision({ 700, 1000, 400 }));
+    ASSERT_EQ(SprtDecision::ACCEPT_H0, sprt.getDecision({ 500, 1000, 500 }));
+    ASSERT_GT(sprt.getLogLikelihoodRatio({ 60, 100, 40 }),
+              sprt.getLogLikelihoodRatio({ 50, 100, 50 }));
+
+    MatchResults even{ 3, 2, 3 };
+    ASSERT_EQ(0.5, even.getScore());
+    ASSERT_EQ(0, even.getEloDifference());
+    ASSERT_TRUE(std::isinf(MatchResults{ 2, 0, 0 }.getEloDifference()));
+}
+
+/*
+Covers:
+    runMatch
+        openings: some
+        sprt: nullptr
+        num_threads: > 1
+*/
+TEST(MatchTest, RunMatchTest) {
+    constexpr std::size_t NUM_GAMES = 6;
+    constexpr std::size_t MAX_PLIES = 12;
+    std::vector<std::vector<Move>> openings = {
+        { Move{ Square(1, 0), Square(2, 0) } },
+        { Move{ Square(1, 7), Square(2, 7) },
+          Move{ Square(6, 0), Square(5, 0) } },
+    };
+    std::vector<MatchGameResult> games;
+    MatchResults results = player::computer::runMatch(
+            ENGINE, ENGINE, openings, { NUM_GAMES, 3, MAX_PLIES, nullptr },
+            [&games](const MatchGameResult& game, const MatchResults& so_far) {
+        games.push_back(game);
+        ASSERT_EQ(games.size(), so_far.getNumGames());
+    });
+
+    ASSERT_EQ(NUM_GAMES, results.getNumGames());
+    ASSERT_EQ(NUM_GAMES, games.size());
+    std::vector<bool> played(NUM_GAMES, false);
+    for (const MatchGameResult& game : games) {
+        ASSERT_LT(game.game_index, NUM_GAMES);
+        ASSERT_FALSE(played[game.game_index]);
+        played[game.game_index] = true;
+        // each opening is played by both engines with both colors
+        ASSERT_EQ((game.game_index / 2) % openings.size(), game.opening_index);
+        ASSERT_EQ((game.game_index % 2 == 0) ? game::START_COLOR
+                  : board::oppositeColor(game::START_COLOR),
+                  game.first_color);
+        ASSERT_LE(game.num_plies, MAX_PLIES);
+    }
+}
+
+/*
+Covers:
+    runMatch
+        openings: none, invalid
+        sprt: decides before num_games
+        num_threads: 1
+*/
+TEST(MatchTest, SprtStopTest) {
+    // every game is a draw (i.e. the engines are equally strong)
+    Sprt sprt(0, 100, 0.05, 0.05);
+    MatchResults results = player::computer::runMatch(
+            ENGINE, ENGINE, {}, { 1000, 1, 0, &sprt }, nullptr);
+    ASSERT_EQ(results.getNumGames(), results.num_draws);
+    ASSERT_LT(results.getNumGames(), 1000u);
+    ASSERT_EQ(SprtDecision::ACCEPT_H0, sprt.getDecision(results));
+
+    MatchOptions options{ 2, 1, 10, nullptr };
+    ASSERT_THROW(player::computer::runMatch(
+                         ENGINE, ENGINE,
+                         { { Move{ Square(1, 0), Square(3, 0) } } }, options,
+                         nullptr),
+                 game::InvalidMoveEx);
+    options.num_threads = 0;
+    ASSERT_THROW(player::computer::runMatch(ENGINE, ENGINE, {}, options,
+                                            nullptr),
+                 std::invalid_argument);
+}
@@ -0,0 +1,83 @@
+// Copyright 2021 Alex Theimer
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/move.h"
+#include "player/computer/moveorder.h"
+
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+using game::CompressedMove;
+using game::Move;
+
+using player::computer::MoveOrdering;
+
+/*
+~~~ Test Partitions ~~~
+MoveOrdering::getCaptureScore
+    victims: different, same
+MoveOrdering::updateCutoff
+    move: quiet, capture
+    move: already the newest killer, not a killer
+*/
+
+/*
+Covers:
+    MoveOrdering::getCaptureScore
+        victims: different, same
+*/
+TEST(MoveOrderingTest, CaptureScoreTest) {
+    Board board({
+        { Square(0, 0), Piece{ PieceType::QUEEN, PieceColor::WHITE } },
+        { Square(1, 1), Piece{ PieceType::PAWN, PieceColor::WHITE } },
+        { Square(2, 2), Piece{ PieceType::ROOK, PieceColor::BLACK } },
+        { Square(0, 5), Piece{ PieceType::KING, PieceColor::BLACK } },
+    });
+    CompressedMove queen_takes_king = game::compressMove(
+            Move{ Square(0, 0), Square(0, 5) }) | game::MOVE_FLAG_CAPTURE;
+    CompressedMove queen_takes_rook = game::compressMove(
+            Move{ Square(0, 0), Square(2, 2) }) | game::MOVE_FLAG_CAPTURE;
+    CompressedMove pawn_takes_rook = game::compressMove(
+            Move{ Square(1, 1), Square(2, 2) }) | game::MOVE_FLAG_CAPTURE;
+
+    // most valuable victim first...
+    ASSERT_GT(MoveOrdering::getCaptureScore(board, queen_takes_king),
+              MoveOrdering::getCaptureScore(board, queen_takes_rook));
+    // ...then least valuable attacker
+    ASSERT_GT(MoveOrdering::getCaptureScore(board, pawn_takes_rook),
+              MoveOrdering::getCaptureScore(board, queen_takes_rook));
+}
+
+/*
+Covers:
+    MoveOrdering::updateCutoff
+        move: quiet, capture
+        move: already the newest killer, not a killer
+*/
+TEST(MoveOrderingTest, UpdateCutoffTest) {
+    MoveOrdering ordering;
+    CompressedMove first = game::compressMove(
+            Move{ Square(1, 1), Square(2, 1) });
+    CompressedMove second = game::compressMove(
+            Move{ Square(1, 2), Square(2, 2) });
+    CompressedMove capture = game::compressMove(
+            Move{ Square(1, 3), Square(2, 3) }) | game::MOVE_FLAG_CAPTURE;
+
+    ordering.updateCutoff(PieceColor::WHITE, first, 3, 2);
+    ordering.updateCutoff(PieceColor::WHITE, second, 3, 3);
+    ordering.updateCutoff(PieceColor::WHITE, second, 3, 1);
+    ordering.updateCutoff(PieceColor::WHITE, capture, 3, 5);
+
+    ASSERT_EQ(second, ordering.getKiller(3, 0));
+    ASSERT_EQ(first, ordering.getKiller(3, 1));
+    ASSERT_EQ(game::EMPTY_COMPRESSED_MOVE, ordering.getKiller(4, 0));
+
+    ASSERT_EQ(4, ordering.getHistoryScore(PieceColor::WHITE, first));
+    ASSERT_EQ(10, ordering.getHistoryScore(PieceColor::WHITE, second));
+    ASSERT_EQ(0, ordering.getHistoryScore(PieceColor::BLACK, second));
+    ASSERT_EQ(0, ordering.getHistoryScore(PieceColor::WHITE, capture));
+}
@@ -0,0 +1,221 @@
+// Copyright 2021 Alex Theimer
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "game/move.h"
+#include "player/computer/moveorder.h"
+#include "player/computer/movepicker.h"
+#include "util/buffer.h"
+
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+using game::CompressedMove;
+using game::Move;
+
+using player::computer::MoveOrdering;
+using player::computer::MovePicker;
+
+/*
+~~~ Test Partitions ~~~
+MovePicker::next
+    best_move: empty, valid quiet, valid capture, invalid
+    board: has captures, has no captures
+    killers: valid here, invalid here, same as best_move
+    constructor: full, captures only
+    calls: first (best move valid), later
+*/
+
+/*
+Drains a MovePicker into a vector.
+*/
+std::vector<CompressedMove> drainPicker(MovePicker* picker) {
+    std::vector<CompressedMove> moves;
+    for (CompressedMove move = picker->next();
+            move != game::EMPTY_COMPRESSED_MOVE;
+            move = picker->next()) {
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+/*
+For a range of best moves, confirms the picker returns every move of
+getAllMoves exactly once: the (valid) best move first, then all captures
+by descending MVV-LVA score, then the valid killer, then all other
+quiets by descending history score.
+
+Covers:
+    MovePicker::next
+        best_move: empty, valid quiet, valid capture, invalid
+        board: has captures, has no captures
+        killers: valid here, invalid here, same as best_move
+        constructor: full
+*/
+TEST(MovePickerTest, StageOrderTest) {
+    std::vector<std::unordered_map<Square, Piece>> piece_maps = {
+        game::INIT_PIECE_MAP,
+        {
+            { Square(0, 0), Piece{ PieceType::ROOK, PieceColor::WHITE } },
+            { Square(0, 2), Piece{ PieceType::PAWN, PieceColor::WHITE } },
+            { Square(2, 0), Piece{ PieceType::KNIGHT, PieceColor::BLACK } },
+            { Square(5, 5), Piece{ PieceType::QUEEN, PieceColor::WHITE } },
+            { Square(2, 2), Piece{ PieceType::BISHOP, PieceColor::BLACK } },
+        }
+    };
+
+    for (auto& piece_map : piece_maps) {
+        Board board(piece_map);
+        util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+        std::size_t num_moves = game::getAllMoves(board, PieceColor::WHITE,
+                                                  move_buffer.start());
+        std::unordered_set<CompressedMove> all_moves(
+                move_buffer.start(), move_buffer.start() + num_moves);
+
+        // try every valid move as the best move, plus a couple invalid ones
+        std::vector<CompressedMove> best_moves(all_moves.begin(),
+                                               all_moves.end());
+        best_moves.push_back(game::EMPTY_COMPRESSED_MOVE);
+        best_moves.push_back(game::compressMove(
+                Move{ Square(3, 3), Square(3, 4) }));
+
+        // one valid killer, one invalid killer, and some history
+        std::vector<CompressedMove> quiets;
+        for (CompressedMove move : all_moves) {
+            if (!game::isCaptureMove(move)) {
+                quiets.push_back(move);
+            }
+        }
+        ASSERT_GE(quiets.size(), 3u);
+        CompressedMove killer = quiets[0];
+        MoveOrdering ordering;
+        ordering.updateCutoff(PieceColor::WHITE, killer, 1, 1);
+        ordering.updateCutoff(PieceColor::WHITE, game::compressMove(
+                Move{ Square(3, 3), Square(3, 4) }), 1, 1);
+        ordering.updateCutoff(PieceColor::WHITE, quiets[1], 2, 4);
+        ordering.updateCutoff(PieceColor::WHITE, quiets[2], 2, 2);
+
+        for (CompressedMove best_move : best_moves) {
+            MovePicker picker(board, PieceColor::WHITE, best_move,
+                              ordering, 1);
+            std::vector<CompressedMove> picked = drainPicker(&picker);
+            ASSERT_EQ(num_moves, picked.size());
+
+            std::size_t i = 0;
+            if (all_moves.count(best_move) > 0) {
+                ASSERT_EQ(best_move, picked[0]);
+                ++i;
+            }
+            std::unordered_set<CompressedMove> seen;
+            for (CompressedMove move : picked) {
+                ASSERT_EQ(1u, all_moves.count(move));
+                ASSERT_TRUE(seen.insert(move).second);
+            }
+            for (; i < picked.size() && game::isCaptureMove(picked[i]);
+                    ++i) {
+                if (i > 0 && game::isCaptureMove(picked[i - 1])
+                        && picked[i - 1] != best_move) {
+                    ASSERT_GE(MoveOrdering::getCaptureScore(board,
+                                                            picked[i - 1]),
+                              MoveOrdering::getCaptureScore(board,
+                                                            picked[i]));
+                }
+            }
+            if (best_move != killer) {
+                ASSERT_EQ(killer, picked[i]);
+                ++i;
+            }
+            std::size_t first_quiet = i;
+            for (; i < picked.size(); ++i) {
+                ASSERT_FALSE(game::isCaptureMove(picked[i]))
+                        << "capture after a quiet";
+                if (i > first_quiet) {
+                    ASSERT_GE(ordering.getHistoryScore(PieceColor::WHITE,
+                                                       picked[i - 1]),
+                              ordering.getHistoryScore(PieceColor::WHITE,
+                                                       picked[i]));
+                }
+            }
+        }
+    }
+}
+
+/*
+Confirms a captures-only picker returns exactly the captures, by
+descending MVV-LVA score.
+
+Covers:
+    MovePicker::next
+        board: has captures, has no captures
+        constructor: captures only
+*/
+TEST(MovePickerTest, CapturesOnlyTest) {
+    std::vector<std::unordered_map<Square, Piece>> piece_maps = {
+        game::INIT_PIECE_MAP,
+        {
+            { Square(0, 0), Piece{ PieceType::ROOK, PieceColor::WHITE } },
+            { Square(0, 2), Piece{ PieceType::PAWN, PieceColor::WHITE } },
+            { Square(2, 0), Piece{ PieceType::KNIGHT, PieceColor::BLACK } },
+            { Square(5, 5), Piece{ PieceType::QUEEN, PieceColor::WHITE } },
+            { Square(2, 2), Piece{ PieceType::BISHOP, PieceColor::BLACK } },
+        }
+    };
+
+    for (auto& piece_map : piece_maps) {
+        Board board(piece_map);
+        util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+        std::size_t num_captures = game::getAllCaptures(
+                board, PieceColor::WHITE, move_buffer.start());
+        std::unordered_set<CompressedMove> all_captures(
+                move_buffer.start(), move_buffer.start() + num_captures);
+
+        MovePicker picker(board, PieceColor::WHITE);
+        std::vector<CompressedMove> picked = drainPicker(&picker);
+        ASSERT_EQ(num_captures, picked.size());
+        for (std::size_t i = 0; i < picked.size(); ++i) {
+            ASSERT_EQ(1u, all_captures.count(picked[i]));
+            if (i > 0) {
+                ASSERT_GE(MoveOrdering::getCaptureScore(board, picked[i - 1]),
+                          MoveOrdering::getCaptureScore(board, picked[i]));
+            }
+        }
+    }
+}
+
+/*
+Confirms the captures are only generated once the best move has been
+returned and another move is asked for: the Board loses its captures
+after the first call (against the MovePicker's note, on purpose), so
+captures generated any earlier would still be returned.
+
+Covers:
+    MovePicker::next
+        calls: first (best move valid), later
+*/
+TEST(MovePickerTest, LazyCapturesTest) {
+    Board board({
+        { Square(0, 0), Piece{ PieceType::ROOK, PieceColor::WHITE } },
+        { Square(7, 7), Piece{ PieceType::KING, PieceColor::WHITE } },
+        { Square(0, 5), Piece{ PieceType::KNIGHT, PieceColor::BLACK } },
+    });
+    CompressedMove best_move = game::compressMove(
+            Move{ Square(7, 7), Square(6, 7) });
+    MoveOrdering ordering;
+    MovePicker picker(board, PieceColor::WHITE, best_move, ordering, 1);
+
+    ASSERT_EQ(best_move, picker.next());
+    board.removePiece(Square(0, 5));
+    std::vector<CompressedMove> picked = drainPicker(&picker);
+    ASSERT_FALSE(picked.empty());
+    for (CompressedMove move : picked) {
+        ASSERT_FALSE(game::isCaptureMove(move));
+    }
+}
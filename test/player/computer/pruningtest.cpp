@@ -0,0 +1,63 @@
+// Copyright 2021 Alex Theimer
+
+#include "gtest/gtest.h"
+#include "game/move.h"
+#include "player/computer/pruning.h"
+
+using player::computer::PruningParams;
+using player::computer::ReductionTable;
+
+/*
+~~~ Test Partitions ~~~
+ReductionTable::get
+    params: no pruning, default
+    depth_remaining: below lmr_min_depth, at least lmr_min_depth
+    move_index: below lmr_min_move_index, at least lmr_min_move_index
+*/
+
+/*
+Covers:
+    ReductionTable::get
+        params: no pruning
+*/
+TEST(ReductionTableTest, DisabledTest) {
+    ReductionTable table(player::computer::NO_PRUNING_PARAMS);
+    for (std::size_t depth = 0; depth <= ReductionTable::MAX_DEPTH; ++depth) {
+        for (std::size_t index = 0; index < game::MAX_NUM_MOVES_PLY;
+                ++index) {
+            ASSERT_EQ(0u, table.get(depth, index));
+        }
+    }
+}
+
+/*
+Confirms reductions only start at the configured depth and move index,
+never increase with earlier moves or shallower depths, and always leave
+a ply to search.
+
+Covers:
+    ReductionTable::get
+        params: default
+        depth_remaining: below lmr_min_depth, at least lmr_min_depth
+        move_index: below lmr_min_move_index, at least lmr_min_move_index
+*/
+TEST(ReductionTableTest, DefaultTest) {
+    const PruningParams& params = player::computer::DEFAULT_PRUNING_PARAMS;
+    ReductionTable table(params);
+    for (std::size_t depth = 0; depth <= ReductionTable::MAX_DEPTH; ++depth) {
+        for (std::size_t index = 0; index < game::MAX_NUM_MOVES_PLY;
+                ++index) {
+            std::size_t reduction = table.get(depth, index);
+            if (depth < params.lmr_min_depth
+                    || index < params.lmr_min_move_index) {
+                ASSERT_EQ(0u, reduction);
+                continue;
+            }
+            ASSERT_LT(reduction, depth);
+            ASSERT_GE(reduction, table.get(depth, index - 1));
+            ASSERT_GE(reduction, table.get(depth - 1, index));
+        }
+    }
+    ASSERT_GT(table.get(ReductionTable::MAX_DEPTH,
+                        game::MAX_NUM_MOVES_PLY - 1), 0u);
+}
@@ -0,0 +1,650 @@
+// Copyright 2021 Alex Theimer
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "board/zobhash.h"
+#include "game/game.h"
+#include "game/move.h"
+#include "player/computer/search.h"
+#include "player/computer/tablebase.h"
+#include "player/computer/transposition.h"
+#include "util/buffer.h"
+
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+
+using game::CompressedMove;
+using game::Move;
+
+using player::computer::BoardScore;
+using player::computer::ITranspositionTable;
+using player::computer::ScoreBound;
+using player::computer::SearchLimits;
+using player::computer::SearchStats;
+using player::computer::StopToken;
+using player::computer::TTEntry;
+
+/*
+~~~ Test Partitions ~~~
+alphaBetaSearch
+    transposition table: empty, populated by an earlier search
+    depth: 1, > 1
+    num_threads: 1, > 1
+    horizon: mid-exchange
+negamaxSearch
+    evaluator: BasicBoardEvaluator
+    board: initial, midgame, king capturable
+    limits: depth only, hard time, node count
+    stop_token: nullptr, stopped during the search
+    principal_variation: nullptr, not nullptr
+    pruning: none, default
+    tablebases: nullptr, hold the board's endgame
+    history: nullptr, holds a child's position
+*/
+
+/*
+Unbounded transposition table that always replaces.
+Guarded by a mutex, since helper threads share it.
+*/
+class MapTranspositionTable : public ITranspositionTable {
+ public:
+    bool probe(const Board& board, PieceColor color,
+               TTEntry* entry) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = map_.find(key(board, color));
+        if (iter == map_.end()) {
+            return false;
+        }
+        *entry = iter->second;
+        return true;
+    }
+
+    bool store(const Board& board, PieceColor color, BoardScore score,
+               CompressedMove best_move, std::size_t draft,
+               ScoreBound bound) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_[key(board, color)] = TTEntry{ score, best_move,
+                                           static_cast<uint8_t>(draft),
+                                           bound, 0 };
+        // nothing is ever evicted
+        return false;
+    }
+
+    void newSearch() override {
+        // intentionally blank
+    }
+
+    std::size_t getHashfull() const override {
+        // never fills up
+        return 0;
+    }
+
+ private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::size_t, TTEntry> map_;
+
+    static std::size_t key(const Board& board, PieceColor color) {
+        return board::applyZobSideToMove(std::hash<Board>{}(board), color);
+    }
+};
+
+/*
+Confirms the search finds the only piece-winning move, whether or not
+the transposition table was populated by earlier (or concurrent,
+deeper) searches.
+
+Covers:
+    alphaBetaSearch
+        transposition table: empty, populated by an earlier search
+        depth: 1, > 1
+        num_threads: 1, > 1
+*/
+TEST(SearchTest, WinningCaptureTest) {
+    // If it isn't captured now, the knight can always outrun the king.
+    Board board({
+        { Square(3, 3), Piece{ PieceType::KING, PieceColor::WHITE } },
+        { Square(3, 4), Piece{ PieceType::KNIGHT, PieceColor::BLACK } },
+        { Square(0, 7), Piece{ PieceType::KING, PieceColor::BLACK } },
+    });
+    CompressedMove expected = game::compressMove(
+            Move{ Square(3, 3), Square(3, 4) });
+
+    for (std::size_t num_threads : { 1, 4 }) {
+        MapTranspositionTable table;
+        for (std::size_t depth : { 1, 3, 3, 4, 2 }) {
+            CompressedMove move = player::computer::alphaBetaSearch(
+                    board, PieceColor::WHITE, depth,
+                    &player::computer::basicBoardHeuristic, &table,
+                    num_threads);
+            ASSERT_TRUE(game::isSameMove(expected, move))
+                    << "depth: " << depth << ", num_threads: " << num_threads;
+        }
+    }
+}
+
+/*
+Own material minus the opponent's (unlike basicBoardHeuristic, losing
+a piece costs something).
+*/
+BoardScore materialHeuristic(const Board& board, PieceColor color) {
+    util::Buffer<Square, Board::SIZE> square_buffer;
+    std::size_t num_squares = board.getOccupiedSquares(
+            square_buffer.start());
+    BoardScore score = 0;
+    for (std::size_t i = 0; i < num_squares; ++i) {
+        Piece piece = board.getPiece(square_buffer.get(i));
+        BoardScore value = 1;
+        if (piece.type == PieceType::QUEEN) {
+            value = 9;
+        }
+        score += (piece.color == color) ? value : -value;
+    }
+    return score;
+}
+
+/*
+Confirms even a depth-1 search sees the recapture of a defended piece.
+
+Covers:
+    alphaBetaSearch
+        depth: 1
+        horizon: mid-exchange
+*/
+TEST(SearchTest, HorizonTest) {
+    // The pawn is defended by the rook.
+    Board board({
+        { Square(0, 0), Piece{ PieceType::QUEEN, PieceColor::WHITE } },
+        { Square(4, 4), Piece{ PieceType::KING, PieceColor::WHITE } },
+        { Square(0, 1), Piece{ PieceType::PAWN, PieceColor::BLACK } },
+        { Square(7, 1), Piece{ PieceType::ROOK, PieceColor::BLACK } },
+    });
+    CompressedMove losing = game::compressMove(
+            Move{ Square(0, 0), Square(0, 1) });
+
+    MapTranspositionTable table;
+    CompressedMove move = player::computer::alphaBetaSearch(
+            board, PieceColor::WHITE, 1, &materialHeuristic, &table, 1);
+    ASSERT_FALSE(game::isSameMove(losing, move));
+}
+
+/*
+Minimax over captures only: the player to move may also decline every
+capture (i.e. "stand pat"). Scores are from the perspective of
+`root_color`.
+
+Capture sequences branch too quickly to search exhaustively, so this
+prunes with (min/max) alpha-beta; the score is exact within
+(alpha, beta).
+*/
+BoardScore quiesce(Board* board, PieceColor color, PieceColor root_color,
+                   BoardScore alpha, BoardScore beta) {
+    BoardScore best = player::computer::basicBoardHeuristic(*board,
+                                                            root_color);
+    bool maximizing = color == root_color;
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves = game::getAllCaptures(*board, color,
+                                                 move_buffer.start());
+    for (std::size_t i = 0; i < num_moves; ++i) {
+        if (maximizing ? best >= beta : best <= alpha) {
+            break;
+        }
+        if (maximizing) {
+            alpha = std::max(alpha, best);
+        } else {
+            beta = std::min(beta, best);
+        }
+        game::UndoInfo undo_info = game::makeMove(board, move_buffer.get(i));
+        BoardScore score = quiesce(board, board::oppositeColor(color),
+                                   root_color, alpha, beta);
+        game::unmakeMove(board, move_buffer.get(i), undo_info);
+        best = maximizing ? std::max(best, score) : std::min(best, score);
+    }
+    return best;
+}
+
+/*
+Plain minimax, extended by quiesce() at depth 0: the score of the
+Board from the perspective of `root_color`, whether or not `color`
+(the color to move) is root_color.
+*/
+BoardScore minimax(Board* board, PieceColor color, PieceColor root_color,
+                   std::size_t depth) {
+    if (depth == 0) {
+        return quiesce(board, color, root_color,
+                       -player::computer::MAX_SCORE,
+                       player::computer::MAX_SCORE);
+    }
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves = game::getAllMoves(*board, color,
+                                              move_buffer.start());
+    if (num_moves == 0) {
+        return player::computer::basicBoardHeuristic(*board, root_color);
+    }
+    std::vector<BoardScore> scores;
+    for (std::size_t i = 0; i < num_moves; ++i) {
+        game::UndoInfo undo_info = game::makeMove(board, move_buffer.get(i));
+        scores.push_back(minimax(board, board::oppositeColor(color),
+                                 root_color, depth - 1));
+        game::unmakeMove(board, move_buffer.get(i), undo_info);
+    }
+    return (color == root_color)
+            ? *std::max_element(scores.begin(), scores.end())
+            : *std::min_element(scores.begin(), scores.end());
+}
+
+/*
+Confirms every move chosen by the search is worth the Board's minimax
+score, whether the table is fresh or reused.
+
+Covers:
+    negamaxSearch
+        evaluator: BasicBoardEvaluator
+        board: initial, midgame
+        limits: depth only
+        principal_variation: nullptr
+        pruning: none
+*/
+TEST(SearchTest, MinimaxAgreementTest) {
+    constexpr std::size_t DEPTH = 3;
+    SearchLimits limits{ DEPTH, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    for (std::size_t num_plies : { 0, 6, 12 }) {
+        Board board(game::INIT_PIECE_MAP);
+        PieceColor color = PieceColor::WHITE;
+        util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+        for (std::size_t ply = 0; ply < num_plies; ++ply) {
+            std::size_t num_moves = game::getAllMoves(board, color,
+                                                      move_buffer.start());
+            game::makeMove(&board, move_buffer.get((ply * 7) % num_moves));
+            color = board::oppositeColor(color);
+        }
+        BoardScore expected = minimax(&board, color, color, DEPTH);
+
+        MapTranspositionTable table;
+        for (std::size_t i = 0; i < 4; ++i) {
+            CompressedMove move = player::computer::negamaxSearch(
+                    board, color, nullptr, limits,
+                    player::computer::NO_PRUNING_PARAMS,
+                    player::computer::BasicBoardEvaluator(), &table,
+                    nullptr, 1, true, nullptr, nullptr, nullptr);
+            game::UndoInfo undo_info = game::makeMove(&board, move);
+            BoardScore actual = minimax(&board, board::oppositeColor(color),
+                                        color, DEPTH - 1);
+            game::unmakeMove(&board, move, undo_info);
+            ASSERT_EQ(expected, actual) << "num_plies: " << num_plies;
+        }
+    }
+}
+
+/*
+Confirms the principal variation starts with the returned move, is
+legal, spans the full depth, and leads to a Board worth the minimax
+score.
+
+Covers:
+    negamaxSearch
+        evaluator: BasicBoardEvaluator
+        board: midgame
+        limits: depth only
+        principal_variation: not nullptr
+        pruning: none
+*/
+TEST(SearchTest, PrincipalVariationTest) {
+    constexpr std::size_t DEPTH = 3;
+    SearchLimits limits{ DEPTH, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    Board board(game::INIT_PIECE_MAP);
+    PieceColor root_color = PieceColor::WHITE;
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    for (std::size_t ply = 0; ply < 12; ++ply) {
+        std::size_t num_moves = game::getAllMoves(board, root_color,
+                                                  move_buffer.start());
+        game::makeMove(&board, move_buffer.get((ply * 5) % num_moves));
+        root_color = board::oppositeColor(root_color);
+    }
+    BoardScore expected = minimax(&board, root_color, root_color, DEPTH);
+
+    MapTranspositionTable table;
+    std::vector<CompressedMove> pv;
+    CompressedMove move = player::computer::negamaxSearch(
+            board, root_color, nullptr, limits,
+            player::computer::NO_PRUNING_PARAMS,
+            player::computer::BasicBoardEvaluator(), &table, nullptr, 1,
+            true, nullptr, nullptr, &pv);
+    ASSERT_EQ(DEPTH, pv.size());
+    ASSERT_EQ(move, pv[0]);
+
+    PieceColor color = root_color;
+    for (CompressedMove pv_move : pv) {
+        std::size_t num_moves = game::getAllMoves(board, color,
+                                                  move_buffer.start());
+        ASSERT_NE(move_buffer.start() + num_moves,
+                  std::find(move_buffer.start(),
+                            move_buffer.start() + num_moves, pv_move));
+        game::makeMove(&board, pv_move);
+        color = board::oppositeColor(color);
+    }
+    ASSERT_EQ(expected, quiesce(&board, color, root_color,
+                                -player::computer::MAX_SCORE,
+                                player::computer::MAX_SCORE));
+}
+
+/*
+Confirms a pruned search still finds the only piece-winning move, and
+searches fewer nodes than a full-width one.
+
+Covers:
+    negamaxSearch
+        evaluator: BasicBoardEvaluator
+        board: midgame
+        limits: depth only
+        pruning: none, default
+*/
+TEST(SearchTest, PruningTest) {
+    constexpr std::size_t DEPTH = 5;
+    SearchLimits limits{ DEPTH, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+
+    // The rook is boxed in by its own pawns, so it can't attack the
+    //     black king to gain time for the capture.
+    Board capture_board({
+        { Square(3, 3), Piece{ PieceType::KING, PieceColor::WHITE } },
+        { Square(3, 4), Piece{ PieceType::KNIGHT, PieceColor::BLACK } },
+        { Square(7, 7), Piece{ PieceType::ROOK, PieceColor::WHITE } },
+        { Square(6, 7), Piece{ PieceType::PAWN, PieceColor::WHITE } },
+        { Square(7, 6), Piece{ PieceType::PAWN, PieceColor::WHITE } },
+        { Square(0, 0), Piece{ PieceType::KING, PieceColor::BLACK } },
+    });
+    CompressedMove expected = game::compressMove(
+            Move{ Square(3, 3), Square(3, 4) });
+    MapTranspositionTable capture_table;
+    CompressedMove move = player::computer::negamaxSearch(
+            capture_board, PieceColor::WHITE, nullptr, limits,
+            player::computer::DEFAULT_PRUNING_PARAMS,
+            player::computer::BasicBoardEvaluator(), &capture_table,
+            nullptr, 1, true, nullptr, nullptr, nullptr);
+    ASSERT_TRUE(game::isSameMove(expected, move));
+
+    Board board(game::INIT_PIECE_MAP);
+    PieceColor color = PieceColor::WHITE;
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    for (std::size_t ply = 0; ply < 12; ++ply) {
+        std::size_t num_moves = game::getAllMoves(board, color,
+                                                  move_buffer.start());
+        game::makeMove(&board, move_buffer.get((ply * 5) % num_moves));
+        color = board::oppositeColor(color);
+    }
+    std::vector<std::size_t> num_nodes;
+    for (const player::computer::PruningParams& pruning :
+            { player::computer::NO_PRUNING_PARAMS,
+              player::computer::DEFAULT_PRUNING_PARAMS }) {
+        MapTranspositionTable table;
+        SearchStats stats;
+        player::computer::negamaxSearch(
+                board, color, nullptr, limits, pruning,
+                player::computer::BasicBoardEvaluator(), &table, nullptr, 1,
+                true, nullptr, &stats, nullptr);
+        ASSERT_EQ(DEPTH, stats.depth);
+        num_nodes.push_back(stats.total.num_nodes);
+    }
+    ASSERT_LT(num_nodes[1], num_nodes[0]);
+}
+
+/*
+Confirms interrupted searches still return a legal move, and that a
+hard deadline is (roughly) honored.
+
+Covers:
+    negamaxSearch
+        evaluator: BasicBoardEvaluator
+        board: initial
+        limits: hard time, node count
+        pruning: default
+*/
+TEST(SearchTest, LimitsTest) {
+    Board board(game::INIT_PIECE_MAP);
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves = game::getAllMoves(board, PieceColor::WHITE,
+                                              move_buffer.start());
+    std::vector<CompressedMove> legal_moves(move_buffer.start(),
+                                            move_buffer.start() + num_moves);
+
+    std::vector<SearchLimits> limits_list = {
+        // only the first iteration may finish
+        { player::computer::MAX_SEARCH_DEPTH,
+          std::chrono::milliseconds::zero(),
+          std::chrono::milliseconds::zero(), 1 },
+        { player::computer::MAX_SEARCH_DEPTH,
+          std::chrono::milliseconds::zero(),
+          std::chrono::milliseconds(50), 0 },
+        { player::computer::MAX_SEARCH_DEPTH,
+          std::chrono::milliseconds(20),
+          std::chrono::milliseconds(50), 0 },
+    };
+    for (const SearchLimits& limits : limits_list) {
+        MapTranspositionTable table;
+        auto start = std::chrono::steady_clock::now();
+        CompressedMove move = player::computer::negamaxSearch(
+                board, PieceColor::WHITE, nullptr, limits,
+                player::computer::DEFAULT_PRUNING_PARAMS,
+                player::computer::BasicBoardEvaluator(), &table, nullptr,
+                2, true, nullptr, nullptr, nullptr);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        ASSERT_NE(legal_moves.end(), std::find(legal_moves.begin(),
+                                               legal_moves.end(), move));
+        ASSERT_LT(elapsed, std::chrono::seconds(1));
+    }
+}
+
+/*
+Confirms a search can be stopped from another thread, and then returns
+a legal move from a completed iteration.
+
+Covers:
+    negamaxSearch
+        evaluator: BasicBoardEvaluator
+        board: initial
+        limits: depth only
+        stop_token: stopped during the search
+*/
+TEST(SearchTest, StopTest) {
+    Board board(game::INIT_PIECE_MAP);
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> move_buffer;
+    std::size_t num_moves = game::getAllMoves(board, PieceColor::WHITE,
+                                              move_buffer.start());
+    std::vector<CompressedMove> legal_moves(move_buffer.start(),
+                                            move_buffer.start() + num_moves);
+    // only a stop can end this search in time
+    SearchLimits limits{ player::computer::MAX_SEARCH_DEPTH,
+                         std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+
+    for (std::size_t num_threads : { 1, 2 }) {
+        MapTranspositionTable table;
+        StopToken stop_token;
+        SearchStats stats;
+        CompressedMove move = game::EMPTY_COMPRESSED_MOVE;
+        auto start = std::chrono::steady_clock::now();
+        std::thread search([&]() {
+            move = player::computer::negamaxSearch(
+                    board, PieceColor::WHITE, nullptr, limits,
+                    player::computer::DEFAULT_PRUNING_PARAMS,
+                    player::computer::BasicBoardEvaluator(), &table,
+                    nullptr, num_threads, true, &stop_token, &stats, nullptr);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stop_token.requestStop();
+        search.join();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        ASSERT_NE(legal_moves.end(), std::find(legal_moves.begin(),
+                                               legal_moves.end(), move));
+        ASSERT_GE(stats.depth, 1u);
+        ASSERT_LT(elapsed, std::chrono::seconds(1));
+    }
+}
+
+/*
+Confirms the node limit counts the nodes of every thread.
+
+Covers:
+    negamaxSearch
+        evaluator: BasicBoardEvaluator
+        board: initial
+        limits: node count
+*/
+TEST(SearchTest, NodeLimitTest) {
+    constexpr std::size_t MAX_NODES = 100000;
+    SearchLimits limits{ player::computer::MAX_SEARCH_DEPTH,
+                         std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), MAX_NODES };
+    Board board(game::INIT_PIECE_MAP);
+    for (std::size_t num_threads : { 1, 3 }) {
+        MapTranspositionTable table;
+        SearchStats stats;
+        player::computer::negamaxSearch(
+                board, PieceColor::WHITE, nullptr, limits,
+                player::computer::DEFAULT_PRUNING_PARAMS,
+                player::computer::BasicBoardEvaluator(), &table,
+                nullptr, num_threads, true, nullptr, &stats, nullptr);
+        // Threads report in batches, and keep searching until they
+        //     next check the stop flag; that's well under this slack.
+        ASSERT_LT(stats.total.num_nodes, 2 * MAX_NODES);
+        ASSERT_GE(stats.total.num_nodes, MAX_NODES);
+    }
+}
+
+/*
+Confirms a search with tablebases plays the quickest win they know of.
+
+Covers:
+    negamaxSearch
+        evaluator: BasicBoardEvaluator
+        board: endgame
+        tablebases: hold the board's endgame
+*/
+TEST(SearchTest, TablebaseTest) {
+    std::string directory = testing::TempDir() + "searchtest_tablebases";
+    player::computer::Tablebases::generate("KQvK", directory, 1);
+    player::computer::Tablebases tablebases(directory);
+
+    // the first position (in square order) that takes a while to win
+    constexpr int MIN_VALUE = 7;
+    Square black_king(3, 3);
+    Square white_king(7, 0);
+    auto makeBoard = [&](Square queen) {
+        return std::unordered_map<Square, Piece>{
+            { black_king, Piece{ PieceType::KING, PieceColor::BLACK } },
+            { white_king, Piece{ PieceType::KING, PieceColor::WHITE } },
+            { queen, Piece{ PieceType::QUEEN, PieceColor::WHITE } },
+        };
+    };
+    Square queen(0, 0);
+    int value = 0;
+    for (std::size_t index = 0; index < Square::NUM_SQUARES; ++index) {
+        queen = Square::indexToSquare(index);
+        if (queen == black_king || queen == white_king) {
+            continue;
+        }
+        ASSERT_TRUE(tablebases.probe(Board(makeBoard(queen)),
+                                     PieceColor::WHITE, &value));
+        if (value >= MIN_VALUE) {
+            break;
+        }
+    }
+    ASSERT_GE(value, MIN_VALUE);
+    Board board(makeBoard(queen));
+
+    SearchLimits limits{ 3, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    MapTranspositionTable table;
+    SearchStats stats;
+    CompressedMove move = player::computer::negamaxSearch(
+            board, PieceColor::WHITE, nullptr, limits,
+            player::computer::DEFAULT_PRUNING_PARAMS,
+            player::computer::BasicBoardEvaluator(), &table, &tablebases, 1,
+            true, nullptr, &stats, nullptr);
+    ASSERT_GT(stats.total.num_tablebase_hits, 0u);
+
+    game::makeMove(&board, move);
+    int child_value;
+    ASSERT_TRUE(tablebases.probe(board, PieceColor::BLACK, &child_value));
+    ASSERT_EQ(-(value - 1), child_value);
+}
+
+/*
+Confirms a child that repeats a position of the game is scored as a
+draw rather than searched (i.e. it's never stored in the table).
+
+Covers:
+    negamaxSearch
+        history: nullptr, holds a child's position
+*/
+TEST(SearchTest, RepetitionTest) {
+    Board board(game::INIT_PIECE_MAP);
+    Move repeating{ Square(0, 1), Square(2, 2) };
+    Board child(board);
+    game::makeMove(&child, game::compressMove(repeating));
+    std::vector<std::size_t> history = {
+        game::getPositionKey(child, PieceColor::WHITE)
+    };
+
+    SearchLimits limits{ 2, std::chrono::milliseconds::zero(),
+                         std::chrono::milliseconds::zero(), 0 };
+    for (bool has_history : { false, true }) {
+        MapTranspositionTable table;
+        player::computer::negamaxSearch(
+                board, PieceColor::BLACK, has_history ? &history : nullptr,
+                limits, player::computer::NO_PRUNING_PARAMS,
+                player::computer::BasicBoardEvaluator(), &table, nullptr, 1,
+                true, nullptr, nullptr, nullptr);
+        TTEntry entry;
+        ASSERT_EQ(!has_history, table.probe(child, PieceColor::WHITE, &entry));
+    }
+}
+
+/*
+Confirms the search captures the king as soon as it can, rather than
+first winning material (every line of which also captures the king
+later), and that it returns a line ending with the capture.
+
+Covers:
+    negamaxSearch
+        board: king capturable
+*/
+TEST(SearchTest, KingCaptureTest) {
+    Board board({
+        { Square(7, 7), Piece{ PieceType::KING, PieceColor::WHITE } },
+        { Square(0, 5), Piece{ PieceType::QUEEN, PieceColor::WHITE } },
+        { Square(0, 0), Piece{ PieceType::KING, PieceColor::BLACK } },
+        { Square(4, 5), Piece{ PieceType::ROOK, PieceColor::BLACK } },
+    });
+    CompressedMove expected = game::compressMove(
+            Move{ Square(0, 5), Square(0, 0) });
+
+    for (std::size_t depth : { 1, 2, 4 }) {
+        SearchLimits limits{ depth, std::chrono::milliseconds::zero(),
+                             std::chrono::milliseconds::zero(), 0 };
+        MapTranspositionTable table;
+        std::vector<CompressedMove> pv;
+        CompressedMove move = player::computer::negamaxSearch(
+                board, PieceColor::WHITE, nullptr, limits,
+                player::computer::DEFAULT_PRUNING_PARAMS,
+                player::computer::BasicBoardEvaluator(), &table, nullptr, 1,
+                true, nullptr, nullptr, &pv);
+        ASSERT_TRUE(game::isSameMove(expected, move)) << "depth: " << depth;
+        // nothing is searched after the game ends
+        ASSERT_EQ(1u, pv.size());
+    }
+}
@@ -0,0 +1,155 @@
+// Copyright 2021 Alex Theimer
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "board/board.h"
+#include "game/game.h"
+#include "game/move.h"
+#include "player/computer/tablebase.h"
+#include "util/buffer.h"
+
+using board::Board;
+using board::Piece;
+using board::PieceColor;
+using board::PieceType;
+using board::Square;
+using game::CompressedMove;
+using player::computer::Tablebases;
+
+/*
+~~~ Test Partitions ~~~
+Tablebases::generate
+    name: valid, invalid, too many pieces
+    name: stronger side first, weaker side first
+Tablebases::probe
+    position: in a table, not in any table
+    stronger side's color: BLACK, WHITE
+    player to move: stronger side, weaker side
+*/
+
+/*
+Returns the value a table should hold for a position, given the
+values of every position after one of its moves.
+*/
+static int getExpectedValue(const Tablebases& tablebases, Board* board,
+                            PieceColor color) {
+    util::Buffer<CompressedMove, game::MAX_NUM_MOVES_PLY> moves;
+    std::size_t num_moves = game::getAllMoves(*board, color, moves.start());
+    int best_win = 0;
+    int worst_loss = 0;
+    bool has_draw = false;
+    for (std::size_t i = 0; i < num_moves; ++i) {
+        CompressedMove move = moves.get(i);
+        if (game::isCaptureMove(move)
+                && board->getPiece(Square::indexToSquare(
+                           game::getMoveToIndex(move))).type
+                   == PieceType::KING) {
+            best_win = 1;
+            continue;
+        }
+        game::UndoInfo undo_info = game::makeMove(board, move);
+        int child_value;
+        EXPECT_TRUE(tablebases.probe(*board, board::oppositeColor(color),
+                                     &child_value));
+        game::unmakeMove(board, move, undo_info);
+        if (child_value < 0) {
+            int win = 1 - child_value;
+            best_win = (best_win == 0) ? win : std::min(best_win, win);
+        } else if (child_value > 0) {
+            worst_loss = std::max(worst_loss, child_value + 1);
+        } else {
+            has_draw = true;
+        }
+    }
+    if (best_win > 0) {
+        return best_win;
+    }
+    return has_draw ? 0 : -worst_loss;
+}
+
+/*
+Confirms random positions hold the values implied by their moves
+(i.e. the tables are consistent, and their distances optimal).
+
+Covers:
+    Tablebases::generate
+        name: valid
+        name: stronger side first, weaker side first
+    Tablebases::probe
+        position: in a table
+        stronger side's color: BLACK, WHITE
+        player to move: stronger side, weaker side
+*/
+TEST(TablebaseTest, ConsistencyTest) {
+    std::string directory = testing::TempDir() + "tablebasetest";
+    Tablebases::generate("KRvK", directory, 2);
+    Tablebases::generate("KvKN", directory, 2);
+    Tablebases tablebases(directory);
+    ASSERT_EQ(3u, tablebases.getMaxPieces());
+
+    std::mt19937 rand_gen(1);
+    std::uniform_int_distribution<int> dim(0, 7);
+    std::size_t num_wins = 0;
+    for (PieceType type : { PieceType::ROOK, PieceType::KNIGHT }) {
+        for (std::size_t i = 0; i < 1000; ++i) {
+            PieceColor strong = (i % 2 == 0) ? PieceColor::BLACK
+                                             : PieceColor::WHITE;
+            PieceColor color = (i % 4 < 2) ? strong
+                                           : board::oppositeColor(strong);
+            std::unordered_map<Square, Piece> piece_map;
+            for (Piece piece : { Piece{ PieceType::KING, strong },
+                                 Piece{ PieceType::KING,
+                                        board::oppositeColor(strong) },
+                                 Piece{ type, strong } }) {
+                Square square(dim(rand_gen), dim(rand_gen));
+                while (piece_map.count(square) > 0) {
+                    square = Square(dim(rand_gen), dim(rand_gen));
+                }
+                piece_map[square] = piece;
+            }
+            Board board(piece_map);
+
+            int value;
+            ASSERT_TRUE(tablebases.probe(board, color, &value));
+            ASSERT_EQ(getExpectedValue(tablebases, &board, color), value);
+            num_wins += value > 0;
+        }
+    }
+    ASSERT_GT(num_wins, 0u);
+}
+
+/*
+Covers:
+    Tablebases::generate
+        name: invalid, too many pieces
+    Tablebases::probe
+        position: not in any table
+*/
+TEST(TablebaseTest, InvalidTest) {
+    std::string directory = testing::TempDir() + "tablebasetest_invalid";
+    ASSERT_THROW(Tablebases::generate("KQ", directory, 1),
+                 std::invalid_argument);
+    ASSERT_THROW(Tablebases::generate("KQvQ", directory, 1),
+                 std::invalid_argument);
+    ASSERT_THROW(Tablebases::generate("KXvK", directory, 1),
+                 std::invalid_argument);
+    ASSERT_THROW(Tablebases::generate("KQRvKB", directory, 1),
+                 std::invalid_argument);
+
+    Tablebases::generate("KvK", directory, 1);
+    Tablebases tablebases(directory);
+    int value;
+    Board board(game::INIT_PIECE_MAP);
+    ASSERT_FALSE(tablebases.probe(board, PieceColor::BLACK, &value));
+    Board rook_board({
+        { Square(0, 0), Piece{ PieceType::KING, PieceColor::BLACK } },
+        { Square(7, 7), Piece{ PieceType::KING, PieceColor::WHITE } },
+        { Square(3, 3), Piece{ PieceType::ROOK, PieceColor::WHITE } },
+    });
+    ASSERT_FALSE(tablebases.probe(rook_board, PieceColor::BLACK, &value));
+}
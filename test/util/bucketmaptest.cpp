@@ -0,0 +1,158 @@
+// Copyright 2021 Alex Theimer
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "util/bucketmap.h"
+#include "gtest/gtest.h"
+
+using util::BucketedMap;
+
+/*
+~~~ Test Partitions ~~~
+BucketedMap::find
+    key: present, absent
+BucketedMap::set
+    key: already in bucket, not in bucket
+    bucket: has empty entry, is full
+    threads: one, many
+BucketedMap::getEntry
+    entry: occupied, empty
+*/
+
+/*
+Priority that simply returns the stored value.
+*/
+int64_t valuePriority(const int64_t& value) {
+    return value;
+}
+
+/*
+Covers:
+    BucketedMap::find
+        key: present, absent
+    BucketedMap::set
+        key: already in bucket, not in bucket
+        bucket: has empty entry
+*/
+TEST(BucketedMapTest, FindSetTest) {
+    BucketedMap<int64_t> map(1024);
+    int64_t value = 0;
+    ASSERT_FALSE(map.find(12345, &value));
+
+    for (uint64_t key = 1; key <= 100; ++key) {
+        map.set(key * 0x9E3779B97F4A7C15ULL, key, valuePriority);
+    }
+    for (uint64_t key = 1; key <= 100; ++key) {
+        ASSERT_TRUE(map.find(key * 0x9E3779B97F4A7C15ULL, &value));
+        ASSERT_EQ(static_cast<int64_t>(key), value);
+    }
+
+    map.set(0x9E3779B97F4A7C15ULL, -7, valuePriority);
+    ASSERT_TRUE(map.find(0x9E3779B97F4A7C15ULL, &value));
+    ASSERT_EQ(-7, value);
+
+    map.clear();
+    ASSERT_FALSE(map.find(0x9E3779B97F4A7C15ULL, &value));
+}
+
+/*
+Fills a single bucket, then confirms the lowest-priority entry is the
+one replaced.
+
+Covers:
+    BucketedMap::set
+        key: already in bucket, not in bucket
+        bucket: has empty entry, is full
+*/
+TEST(BucketedMapTest, ReplacementTest) {
+    // one bucket: every key shares it
+    BucketedMap<int64_t> map(1);
+    const std::size_t capacity = map.capacity();
+    ASSERT_EQ(BucketedMap<int64_t>::CACHE_LINE_SIZE / 16, capacity);
+
+    // key i holds priority (10 + i), except key 2 which holds priority 1
+    for (uint64_t key = 1; key <= capacity; ++key) {
+        ASSERT_FALSE(map.set(key, (key == 2) ? 1 : 10 + key, valuePriority));
+    }
+    ASSERT_TRUE(map.set(100, 50, valuePriority));
+    ASSERT_FALSE(map.set(100, 51, valuePriority));
+
+    int64_t value = 0;
+    ASSERT_FALSE(map.find(2, &value));
+    ASSERT_TRUE(map.find(100, &value));
+    for (uint64_t key = 1; key <= capacity; ++key) {
+        if (key != 2) {
+            ASSERT_TRUE(map.find(key, &value)) << "key: " << key;
+        }
+    }
+}
+
+/*
+Covers:
+    BucketedMap::getEntry
+        entry: occupied, empty
+*/
+TEST(BucketedMapTest, GetEntryTest) {
+    BucketedMap<int64_t> map(8);
+    int64_t value = 0;
+    for (std::size_t i = 0; i < map.capacity(); ++i) {
+        ASSERT_FALSE(map.getEntry(i, &value));
+    }
+
+    map.set(3, 30, valuePriority);
+    map.set(5, 50, valuePriority);
+    std::vector<int64_t> values;
+    for (std::size_t i = 0; i < map.capacity(); ++i) {
+        if (map.getEntry(i, &value)) {
+            values.push_back(value);
+        }
+    }
+    ASSERT_EQ(std::vector<int64_t>({ 30, 50 }), values);
+}
+
+/*
+Several threads write and read overlapping keys at once; every value
+found must be the one stored with its key (i.e. never torn).
+
+Covers:
+    BucketedMap::find
+        key: present, absent
+    BucketedMap::set
+        bucket: is full
+    threads: many
+*/
+TEST(BucketedMapTest, ConcurrentTest) {
+    constexpr std::size_t NUM_THREADS = 4;
+    constexpr uint64_t NUM_KEYS = 4096;
+    // few buckets, so threads constantly collide
+    BucketedMap<int64_t> map(16);
+
+    std::vector<std::thread> threads;
+    std::vector<int> torn(NUM_THREADS, 0);
+    for (std::size_t t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&map, &torn, t]() {
+            for (std::size_t round = 0; round < 50; ++round) {
+                for (uint64_t key = 1; key <= NUM_KEYS; ++key) {
+                    uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+                    if ((key + t) % 2 == 0) {
+                        map.set(hash, ~hash, valuePriority);
+                    } else {
+                        int64_t value = 0;
+                        if (map.find(hash, &value)
+                                && value != static_cast<int64_t>(~hash)) {
+                            torn[t] = 1;
+                        }
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (std::size_t t = 0; t < NUM_THREADS; ++t) {
+        ASSERT_FALSE(torn[t]) << "thread: " << t;
+    }
+}
@@ -0,0 +1,61 @@
+// Copyright 2021 Alex Theimer
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "game/game.h"
+#include "player/computer/book.h"
+
+/*
+Builds an opening book from recorded games.
+
+Usage: makebook games_path book_path max_plies
+    games_path: one game per line (see player::computer::parseGameRecord);
+                empty lines are skipped.
+    max_plies: the number of moves of each game to record.
+*/
+int main(int argc, char *argv[]) {
+    if (argc != 4) {
+        std::cerr << "usage: " << argv[0]
+                  << " games_path book_path max_plies" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::ifstream games(argv[1]);
+    if (!games) {
+        std::cerr << "cannot open " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::size_t max_plies = std::stoul(argv[3]);
+
+    player::computer::OpeningBookBuilder builder;
+    std::string line;
+    std::size_t line_number = 0;
+    std::size_t num_games = 0;
+    while (std::getline(games, line)) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        try {
+            builder.addGame(player::computer::parseGameRecord(line),
+                            max_plies);
+            ++num_games;
+        } catch (const std::exception& ex) {
+            // one bad record shouldn't spoil the rest
+            std::cerr << "skipping line " << line_number << ": "
+                      << ex.what() << std::endl;
+        }
+    }
+
+    try {
+        builder.write(argv[2]);
+    } catch (const std::runtime_error& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "recorded " << builder.size() << " moves from "
+              << num_games << " games" << std::endl;
+}
@@ -0,0 +1,36 @@
+// Copyright 2021 Alex Theimer
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "player/computer/tablebase.h"
+
+/*
+Generates endgame tablebases (and every smaller one they depend on).
+
+Usage: maketb directory name...
+    directory: where the tables are written; created if missing.
+    name: a table name, e.g. KQvK (see player::computer::Tablebases).
+*/
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " directory name..."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i < argc; ++i) {
+        try {
+            player::computer::Tablebases::generate(argv[i], argv[1],
+                                                   num_threads);
+        } catch (const std::exception& ex) {
+            std::cerr << argv[i] << ": " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "generated " << argv[i] << std::endl;
+    }
+}
@@ -0,0 +1,212 @@
+// Copyright 2021 Alex Theimer
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "game/game.h"
+#include "player/computer/book.h"
+#include "player/computer/computer.h"
+#include "player/computer/match.h"
+#include "player/computer/search.h"
+
+using player::computer::EngineConfig;
+using player::computer::GameOutcome;
+using player::computer::MatchGameResult;
+using player::computer::MatchOptions;
+using player::computer::MatchResults;
+using player::computer::Sprt;
+using player::computer::SprtDecision;
+
+static const char USAGE[] =
+        " [--openings path] [--games n] [--threads n] [--max-plies n]"
+        " [--sprt elo0 elo1 alpha beta] first_engine second_engine";
+
+/*
+Parses an engine: comma-separated key=value pairs, any of
+    name=<string>, depth=<plies>, nodes=<count>, time=<ms per move>,
+    pruning=<on|off>, hash=<MiB>
+e.g. "name=lmr,depth=6,pruning=on". Unset limits are unlimited, except
+depth, which defaults to 4. The hash defaults to
+player::DEFAULT_HASH_SIZE_MIB.
+@throws std::invalid_argument if the engine is malformed.
+*/
+static EngineConfig parseEngine(const std::string& spec) {
+    EngineConfig engine{ spec, player::DEFAULT_HASH_SIZE_MIB,
+                         { 4, std::chrono::milliseconds::zero(),
+                           std::chrono::milliseconds::zero(), 0 },
+                         player::computer::DEFAULT_PRUNING_PARAMS };
+    std::istringstream stream(spec);
+    std::string pair;
+    while (std::getline(stream, pair, ',')) {
+        std::size_t split = pair.find('=');
+        if (split == std::string::npos) {
+            throw std::invalid_argument("expected key=value: " + pair);
+        }
+        std::string key = pair.substr(0, split);
+        std::string value = pair.substr(split + 1);
+        if (key == "name") {
+            engine.name = value;
+        } else if (key == "depth") {
+            engine.limits.max_depth = std::stoul(value);
+            if (engine.limits.max_depth < 1
+                    || engine.limits.max_depth
+                       > player::computer::MAX_SEARCH_DEPTH) {
+                throw std::invalid_argument("depth out of range: " + value);
+            }
+        } else if (key == "nodes") {
+            engine.limits.max_nodes = std::stoul(value);
+        } else if (key == "time") {
+            // as in bin/chess, a search may overrun its budget 4x
+            engine.limits.soft_time = std::chrono::milliseconds(
+                    std::stoul(value));
+            engine.limits.hard_time = 4 * engine.limits.soft_time;
+        } else if (key == "hash") {
+            engine.hash_size_mib = std::stoul(value);
+            if (engine.hash_size_mib < 1) {
+                throw std::invalid_argument("hash must be >= 1 MiB: " + value);
+            }
+        } else if (key == "pruning" && (value == "on" || value == "off")) {
+            engine.pruning = (value == "on")
+                    ? player::computer::DEFAULT_PRUNING_PARAMS
+                    : player::computer::NO_PRUNING_PARAMS;
+        } else {
+            throw std::invalid_argument("unknown engine option: " + pair);
+        }
+    }
+    return engine;
+}
+
+/*
+Reads one opening per line (see player::computer::parseGameRecord);
+empty lines are skipped.
+@throws std::runtime_error if the file cannot be read.
+@throws std::invalid_argument if a line is malformed.
+*/
+static std::vector<std::vector<game::Move>> readOpenings(
+        const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    std::vector<std::vector<game::Move>> openings;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find_first_not_of(" \t\r") != std::string::npos) {
+            openings.push_back(player::computer::parseGameRecord(line));
+        }
+    }
+    return openings;
+}
+
+static const char* getOutcomeName(GameOutcome outcome) {
+    switch (outcome) {
+    case GameOutcome::WIN:
+        return "win";
+    case GameOutcome::DRAW:
+        return "draw";
+    case GameOutcome::LOSS:
+        return "loss";
+    }
+    return "?";
+}
+
+/*
+Plays a match between two configurations of the Computer, many games at
+once, and prints one line per game (from the first engine's perspective)
+and a summary.
+
+Usage: match [--openings path] [--games n] [--threads n] [--max-plies n]
+             [--sprt elo0 elo1 alpha beta] first_engine second_engine
+    path: one opening per line, as recorded games (see tools/makebook.cpp);
+          each is played twice, the engines swapping colors.
+    games: the most games to play (default 100).
+    threads: games played at once (default: one per core).
+    max-plies: longer games are draws (default 400).
+    sprt: stops as soon as the first engine is decided to be elo0 or
+          elo1 stronger, with error rates alpha and beta
+          (e.g. 0 10 0.05 0.05).
+    engine: see parseEngine.
+*/
+int main(int argc, char *argv[]) {
+    std::vector<std::vector<game::Move>> openings;
+    MatchOptions options{ 100, std::max(1u,
+                                        std::thread::hardware_concurrency()),
+                          400, nullptr };
+    std::unique_ptr<Sprt> sprt;
+    std::vector<EngineConfig> engines;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string option(argv[i]);
+            if (option == "--openings" && i + 1 < argc) {
+                openings = readOpenings(argv[++i]);
+            } else if (option == "--games" && i + 1 < argc) {
+                options.num_games = std::stoul(argv[++i]);
+            } else if (option == "--threads" && i + 1 < argc) {
+                options.num_threads = std::stoul(argv[++i]);
+            } else if (option == "--max-plies" && i + 1 < argc) {
+                options.max_plies = std::stoul(argv[++i]);
+            } else if (option == "--sprt" && i + 4 < argc) {
+                sprt = std::make_unique<Sprt>(std::stod(argv[i + 1]),
+                                              std::stod(argv[i + 2]),
+                                              std::stod(argv[i + 3]),
+                                              std::stod(argv[i + 4]));
+                i += 4;
+            } else if (option.rfind("--", 0) != 0) {
+                engines.push_back(parseEngine(option));
+            } else {
+                throw std::invalid_argument("unknown option: " + option);
+            }
+        }
+        if (engines.size() != 2) {
+            throw std::invalid_argument("expected two engines");
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        std::cerr << "usage: " << argv[0] << USAGE << std::endl;
+        return EXIT_FAILURE;
+    }
+    options.sprt = sprt.get();
+
+    MatchResults results;
+    try {
+        results = player::computer::runMatch(engines[0], engines[1],
+                                             openings, options,
+                [](const MatchGameResult& game, const MatchResults& so_far) {
+            std::printf("game %zu opening %zu %s %s %zu plies (+%zu =%zu -%zu)"
+                        "\n", game.game_index, game.opening_index,
+                        (game.first_color == board::PieceColor::BLACK)
+                                ? "BLACK" : "WHITE",
+                        getOutcomeName(game.outcome), game.num_plies,
+                        so_far.num_wins, so_far.num_draws,
+                        so_far.num_losses);
+            std::fflush(stdout);
+        });
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%s vs %s: +%zu =%zu -%zu, score %.3f, elo %+.1f\n",
+                engines[0].name.c_str(), engines[1].name.c_str(),
+                results.num_wins, results.num_draws, results.num_losses,
+                results.getScore(), results.getEloDifference());
+    if (sprt != nullptr) {
+        SprtDecision decision = sprt->getDecision(results);
+        std::printf("sprt: llr %.2f (%.2f, %.2f) %s\n",
+                    sprt->getLogLikelihoodRatio(results),
+                    sprt->getLowerBound(), sprt->getUpperBound(),
+                    (decision == SprtDecision::ACCEPT_H0) ? "H0 accepted"
+                    : (decision == SprtDecision::ACCEPT_H1) ? "H1 accepted"
+                    : "undecided");
+    }
+}